@@ -0,0 +1,88 @@
+#include "WoWLandscapeImportCommandlet.h"
+#include "Editor.h"
+#include "Engine/World.h"
+#include "FileHelpers.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "WoWLandscapeImporter/WoWLandscapeImporter.h"
+
+UWoWLandscapeImportCommandlet::UWoWLandscapeImportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UWoWLandscapeImportCommandlet::Main(const FString &Params)
+{
+	FString MapsParam;
+	if (!FParse::Value(*Params, TEXT("Map="), MapsParam, false) || MapsParam.IsEmpty())
+	{
+		UE_LOG(LogWoWLandscapeImporter, Error, TEXT("Usage: -run=WoWLandscapeImport -Map=<Dir>[+<Dir>...] [-Level=/Game/Maps/{Map}]"));
+		return 1;
+	}
+	TArray<FString> MapDirectories;
+	MapsParam.ParseIntoArray(MapDirectories, TEXT("+"), true);
+
+	FString LevelParam = TEXT("/Game/Maps/{Map}");
+	FParse::Value(*Params, TEXT("Level="), LevelParam, false);
+
+	FWoWLandscapeImporterModule &Importer = FModuleManager::LoadModuleChecked<FWoWLandscapeImporterModule>(TEXT("WoWLandscapeImporter"));
+	FParse::Value(*Params, TEXT("WPGridSize="), Importer.WPGridSize);
+	FParse::Value(*Params, TEXT("MaxConcurrentImports="), Importer.MaxConcurrentImports);
+	Importer.bStreamTiles = !FParse::Param(*Params, TEXT("NoStreamTiles"));
+	Importer.bUseTileCache = !FParse::Param(*Params, TEXT("NoTileCache"));
+	Importer.bInstanceModels = FParse::Param(*Params, TEXT("InstanceModels"));
+	Importer.bIncrementalReimport = FParse::Param(*Params, TEXT("Incremental"));
+	Importer.bSkipExistingAssets = FParse::Param(*Params, TEXT("SkipExistingAssets"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	int NumFailed = 0;
+	for (const FString &MapDirectory : MapDirectories)
+	{
+		const double MapStartTime = FPlatformTime::Seconds();
+		const FString MapName = FPaths::GetCleanFilename(MapDirectory);
+		const FString LevelPath = LevelParam.Replace(TEXT("{Map}"), *MapName);
+
+		FText Reason;
+		if (!FPackageName::IsValidLongPackageName(LevelPath, false, &Reason))
+		{
+			UE_LOG(LogWoWLandscapeImporter, Error, TEXT("%s: invalid level path %s (%s)"), *MapName, *LevelPath, *Reason.ToString());
+			NumFailed++;
+			continue;
+		}
+
+		UWorld *World = FPackageName::DoesPackageExist(LevelPath)
+							? UEditorLoadingAndSavingUtils::LoadMap(LevelPath)
+							: UEditorLoadingAndSavingUtils::NewMapFromTemplate(TEXT("/Engine/Maps/Templates/OpenWorld"), false);
+		if (!World)
+		{
+			UE_LOG(LogWoWLandscapeImporter, Error, TEXT("%s: could not open level %s"), *MapName, *LevelPath);
+			NumFailed++;
+			continue;
+		}
+
+		if (!Importer.ImportLandscape(MapDirectory))
+		{
+			UE_LOG(LogWoWLandscapeImporter, Error, TEXT("%s: import failed after %.2f s"), *MapName, FPlatformTime::Seconds() - MapStartTime);
+			NumFailed++;
+			continue;
+		}
+
+		const bool bSaved = UEditorLoadingAndSavingUtils::SaveMap(GEditor->GetEditorWorldContext().World(), LevelPath) &&
+							UEditorLoadingAndSavingUtils::SaveDirtyPackages(true, true);
+		if (!bSaved)
+		{
+			UE_LOG(LogWoWLandscapeImporter, Error, TEXT("%s: could not save %s"), *MapName, *LevelPath);
+			NumFailed++;
+			continue;
+		}
+		if (!Importer.WritePendingManifest())
+			UE_LOG(LogWoWLandscapeImporter, Warning, TEXT("%s: the next -Incremental import will rebuild everything"), *MapName);
+		UE_LOG(LogWoWLandscapeImporter, Display, TEXT("%s: imported into %s in %.2f s"), *MapName, *LevelPath, FPlatformTime::Seconds() - MapStartTime);
+	}
+
+	UE_LOG(LogWoWLandscapeImporter, Display, TEXT("Imported %d of %d maps in %.2f s"), MapDirectories.Num() - NumFailed, MapDirectories.Num(), FPlatformTime::Seconds() - StartTime);
+	return NumFailed > 0 ? 2 : 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WoWLandscapeImportCommandlet.generated.h"
+
+/**
+ * Imports exported maps without the editor UI, for batch imports on build machines:
+ *
+ * UnrealEditor-Cmd <Project> -run=WoWLandscapeImport -Map=<Dir>[+<Dir>...] [-Level=/Game/Maps/{Map}] -unattended -nullrhi
+ *
+ * Maps are imported one after the other, each into the level at -Level with {Map} replaced by the map directory name.
+ * The level is loaded when it exists and created from the Open World template otherwise, then saved with the imported
+ * assets. Optional: -WPGridSize=<n>, -MaxConcurrentImports=<n>, -NoStreamTiles, -NoTileCache, -InstanceModels, and
+ * -Incremental to only rebuild the tiles and placements that changed since the map was last imported into the level.
+ * -SkipExistingAssets reuses textures and meshes imported by earlier maps when their source files are unchanged, which
+ * saves most of the asset import time when batch importing maps that share them.
+ * Returns 0 when every map imported, 1 for bad arguments and 2 when any map failed.
+ */
+UCLASS()
+class UWoWLandscapeImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UWoWLandscapeImportCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
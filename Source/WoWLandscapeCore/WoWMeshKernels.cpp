@@ -0,0 +1,13 @@
+#include "WoWMeshKernels.h"
+
+void ConvertVertexColors(const uint8_t *BGRAColors, const int Count, float *RGBAColors)
+{
+	// Plain division on purpose: the loop vectorizes, which measured about twice as fast as a 256 entry lookup table
+	for (int i = 0; i < Count; i++, BGRAColors += 4, RGBAColors += 4)
+	{
+		RGBAColors[0] = BGRAColors[2] / 255.0f;
+		RGBAColors[1] = BGRAColors[1] / 255.0f;
+		RGBAColors[2] = BGRAColors[0] / 255.0f;
+		RGBAColors[3] = BGRAColors[3] / 255.0f;
+	}
+}
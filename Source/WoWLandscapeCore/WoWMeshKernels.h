@@ -0,0 +1,8 @@
+#pragma once
+
+// Mesh attribute kernels. They only use standard C++ types, so they build outside the engine as well.
+
+#include <cstdint>
+
+/** Converts Count BGRA8 vertex colors into unit RGBA floats, four per color as laid out by FVector4f */
+void ConvertVertexColors(const uint8_t *BGRAColors, const int Count, float *RGBAColors);
@@ -0,0 +1,85 @@
+#include "WoWPlacementCsv.h"
+#include "WoWPlacementKernels.h"
+#include <charconv>
+#include <cstring>
+
+PlacementCsvReader::PlacementCsvReader(const char *Data, const size_t Size)
+	: Cursor(Data), End(Data + Size)
+{
+	// Skip the UTF-8 byte order mark, then the header line
+	if (Size >= 3 && std::memcmp(Data, "\xEF\xBB\xBF", 3) == 0)
+		Cursor += 3;
+	const char *HeaderEnd = static_cast<const char *>(std::memchr(Cursor, '\n', End - Cursor));
+	Cursor = HeaderEnd ? HeaderEnd + 1 : End;
+}
+
+bool PlacementCsvReader::ReadRow(PlacementCsvRow &OutRow)
+{
+	while (Cursor < End)
+	{
+		const char *LineEnd = static_cast<const char *>(std::memchr(Cursor, '\n', End - Cursor));
+		if (!LineEnd)
+			LineEnd = End;
+		const char *Line = Cursor;
+		Cursor = LineEnd < End ? LineEnd + 1 : End;
+
+		// Accept \r\n line endings
+		if (LineEnd > Line && LineEnd[-1] == '\r')
+			LineEnd--;
+		if (LineEnd == Line)
+			continue;
+
+		// Empty fields are kept, so field indices match the CSV columns
+		OutRow.NumFields = 0;
+		const char *FieldStart = Line;
+		for (const char *Char = Line; OutRow.NumFields < PlacementMaxFields; Char++)
+		{
+			if (Char == LineEnd || *Char == ';')
+			{
+				OutRow.Fields[OutRow.NumFields++] = std::string_view(FieldStart, Char - FieldStart);
+				FieldStart = Char + 1;
+				if (Char == LineEnd)
+					break;
+			}
+		}
+		return true;
+	}
+	return false;
+}
+
+double ParsePlacementNumber(std::string_view Field)
+{
+	// from_chars reads the field in place and ignores the C locale, which strtod would follow for the decimal separator.
+	// strtod also skips leading whitespace and a plus sign, so those are accepted here as well.
+	const char *First = Field.data();
+	const char *const Last = First + Field.size();
+	while (First < Last && (*First == ' ' || (*First >= '\t' && *First <= '\r')))
+		First++;
+	if (Last - First > 1 && First[0] == '+' && First[1] != '-' && First[1] != '+')
+		First++;
+
+	double Value = 0.0;
+	std::from_chars(First, Last, Value);
+	return Value;
+}
+
+bool ReadPlacementValues(const PlacementCsvRow &Row, double *Values)
+{
+	if (Row.NumFields < PlacementValueCount + 1)
+		return false;
+	for (int i = 0; i < PlacementValueCount; i++)
+		Values[i] = ParsePlacementNumber(Row.Fields[i + 1]);
+	return true;
+}
+
+int PlacementPathTable::Intern(std::string_view Path)
+{
+	const auto Found = Indices.find(Path);
+	if (Found != Indices.end())
+		return Found->second;
+
+	const int Index = Num();
+	Paths.emplace_back(Path);
+	Indices.emplace(Paths.back(), Index);
+	return Index;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Placement CSV tokenizer. Rows are split in place in the loaded file buffer, so reading a file allocates nothing per row.
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/** Fields past this are not split out, placement rows have 11 to 13 */
+constexpr int PlacementMaxFields = 16;
+
+/** One row of a placement CSV, its fields point into the buffer being read */
+struct PlacementCsvRow
+{
+	std::string_view Fields[PlacementMaxFields];
+	int NumFields = 0;
+};
+
+/** Reads the rows of a ';' separated placement CSV, skipping its header line and empty lines */
+class PlacementCsvReader
+{
+public:
+	/** Data is read in place and must outlive the reader and the rows it returns */
+	PlacementCsvReader(const char *Data, const size_t Size);
+
+	/** Splits the next row into OutRow, returns false at the end of the data */
+	bool ReadRow(PlacementCsvRow &OutRow);
+
+private:
+	const char *Cursor;
+	const char *End;
+};
+
+/** Parses a numeric field like strtod, without copying it and independent of the locale. Returns 0 for empty, malformed or out of range fields. */
+double ParsePlacementNumber(std::string_view Field);
+
+/** Parses fields 1 to PlacementValueCount of a row into Values, returns false if the row is too short */
+bool ReadPlacementValues(const PlacementCsvRow &Row, double *Values);
+
+/**
+ * Assigns an index to every distinct model path, so work per model (resolving the path, checking the file) runs once
+ * per path instead of once per placement. Paths are copied on first use, so the table outlives the CSV buffers.
+ */
+class PlacementPathTable
+{
+public:
+	/** Index of Path, a new index equal to the previous Num() when the path is seen for the first time */
+	int Intern(std::string_view Path);
+
+	int Num() const { return static_cast<int>(Paths.size()); }
+	std::string_view Get(const int Index) const { return Paths[Index]; }
+
+private:
+	std::deque<std::string> Paths; // Deque, so the views used as keys stay valid as it grows
+	std::unordered_map<std::string_view, int> Indices;
+};
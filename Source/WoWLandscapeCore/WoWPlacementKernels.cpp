@@ -0,0 +1,54 @@
+#include "WoWPlacementKernels.h"
+
+// The constants are floats as in the original conversion, so positions stay bit identical
+static constexpr double YardsToCentimeters = 91.44f;
+static constexpr double MapCenterYards = 17066.66656f;
+
+PlacementTransform ConvertMapPlacement(const double *Values, const bool bIsGameObject, const double SeaLevelOffset)
+{
+	PlacementTransform Transform;
+	if (bIsGameObject)
+	{
+		// Game object has data relative to the center of the map, so we need to offset by 17066.66656
+		Transform.Position[0] = (MapCenterYards - Values[1]) * YardsToCentimeters;
+		Transform.Position[1] = (MapCenterYards - Values[0]) * YardsToCentimeters;
+		Transform.Position[2] = Values[2] * YardsToCentimeters + SeaLevelOffset;
+
+		// Quaternion from game object rotation data, W first in the CSV
+		Transform.Quat[0] = -Values[6];
+		Transform.Quat[1] = Values[5];
+		Transform.Quat[2] = -Values[4];
+		Transform.Quat[3] = Values[3];
+		Transform.bHasQuat = true;
+	}
+	else
+	{
+		// Y and Z are swapped, the CSV height is the second coordinate
+		Transform.Position[0] = Values[0] * YardsToCentimeters;
+		Transform.Position[1] = Values[2] * YardsToCentimeters;
+		Transform.Position[2] = Values[1] * YardsToCentimeters + SeaLevelOffset;
+
+		Transform.Rotation[0] = -Values[3];
+		Transform.Rotation[1] = 90 - Values[4];
+		Transform.Rotation[2] = Values[5];
+	}
+	Transform.Scale = Values[7];
+	return Transform;
+}
+
+PlacementTransform ConvertWMOChildPlacement(const double *Values)
+{
+	PlacementTransform Transform;
+	Transform.Position[0] = Values[0] * YardsToCentimeters;
+	Transform.Position[1] = -Values[1] * YardsToCentimeters;
+	Transform.Position[2] = Values[2] * YardsToCentimeters;
+
+	Transform.Quat[0] = -Values[4];
+	Transform.Quat[1] = Values[5];
+	Transform.Quat[2] = -Values[6];
+	Transform.Quat[3] = Values[3];
+	Transform.bHasQuat = true;
+
+	Transform.Scale = Values[7];
+	return Transform;
+}
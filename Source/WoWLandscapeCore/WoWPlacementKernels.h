@@ -0,0 +1,29 @@
+#pragma once
+
+// Conversions from the yards and axes of wow.export's placement CSVs to engine units. Results are plain arrays that the
+// importer turns into FVector, FRotator and FQuat, which keeps this file free of engine headers.
+
+/** Numeric columns after the model path of a placement row: position (3), rotation or quaternion (4) and scale */
+constexpr int PlacementValueCount = 8;
+
+/** A placement in engine space, positions are in centimeters */
+struct PlacementTransform
+{
+	double Position[3] = {};
+
+	/** Pitch, yaw and roll in degrees, used unless bHasQuat is set */
+	double Rotation[3] = {};
+
+	/** (X, Y, Z, W) orientation of game objects and WMO children, which are placed by quaternion */
+	double Quat[4] = {0.0, 0.0, 0.0, 1.0};
+	bool bHasQuat = false;
+
+	/** Unitless scale from the CSV */
+	double Scale = 1.0;
+};
+
+/** Converts a row of a map placement CSV. Values holds CSV fields 1 to 8, SeaLevelOffset is added to the height. */
+PlacementTransform ConvertMapPlacement(const double *Values, const bool bIsGameObject, const double SeaLevelOffset);
+
+/** Converts a row of a WMO's own placement CSV, relative to the WMO. Values holds CSV fields 1 to 8. */
+PlacementTransform ConvertWMOChildPlacement(const double *Values);
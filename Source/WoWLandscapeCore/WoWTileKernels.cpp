@@ -0,0 +1,111 @@
+#include "WoWTileKernels.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define WOW_TILE_KERNELS_NEON 1
+#define WOW_TILE_KERNELS_SSE2 0
+#include <arm_neon.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WOW_TILE_KERNELS_NEON 0
+#define WOW_TILE_KERNELS_SSE2 1
+#include <emmintrin.h>
+#else
+#define WOW_TILE_KERNELS_NEON 0
+#define WOW_TILE_KERNELS_SSE2 0
+#endif
+
+void StitchTileHeightmap(const uint16_t *TileHeights, const int FirstX, const int FirstY, uint16_t *ProxyHeights, const int ProxyOffset, const int ProxyWidth)
+{
+	for (int TileY = FirstY; TileY < 256; TileY++)
+		std::memcpy(ProxyHeights + ProxyOffset + TileY * ProxyWidth + FirstX, TileHeights + TileY * 256 + FirstX, (256 - FirstX) * sizeof(uint16_t));
+}
+
+void StitchChunkWeights(const uint8_t *BGRAPixels, const int ChunkIndex, const int FirstX, const int FirstY, uint8_t *const Weights[4], const int ProxyOffset, const int ProxyWidth)
+{
+	const int ChunkX = (ChunkIndex % 16) * 16;
+	const int ChunkY = (ChunkIndex / 16) * 16;
+	const int StartX = std::max(ChunkX, FirstX);
+	const int StartY = std::max(ChunkY, FirstY);
+
+	// One pass per chunk row splits the alphamap into every weight plane this chunk uses
+	for (int TileY = StartY; TileY < ChunkY + 16; TileY++)
+	{
+		const int TileIndex = TileY * 256 + StartX;
+		const int ProxyIndex = ProxyOffset + TileY * ProxyWidth + StartX;
+		auto Offset = [ProxyIndex](uint8_t *Plane)
+		{ return Plane ? Plane + ProxyIndex : nullptr; };
+		DeinterleaveAlphamapWeights(BGRAPixels + TileIndex * 4, ChunkX + 16 - StartX, Offset(Weights[0]), Offset(Weights[1]), Offset(Weights[2]), Offset(Weights[3]));
+	}
+}
+
+void DeinterleaveAlphamapWeightsScalar(const uint8_t *BGRAPixels, const int Count, uint8_t *R, uint8_t *G, uint8_t *B, uint8_t *Base)
+{
+	for (int i = 0; i < Count; i++)
+	{
+		const uint8_t *Pixel = BGRAPixels + i * 4;
+		if (R)
+			R[i] = Pixel[2];
+		if (G)
+			G[i] = Pixel[1];
+		if (B)
+			B[i] = Pixel[0];
+		if (Base)
+			Base[i] = static_cast<uint8_t>(255 - Pixel[2] - Pixel[1] - Pixel[0]);
+	}
+}
+
+void DeinterleaveAlphamapWeights(const uint8_t *BGRAPixels, const int Count, uint8_t *R, uint8_t *G, uint8_t *B, uint8_t *Base)
+{
+	int i = 0;
+
+#if WOW_TILE_KERNELS_NEON
+	const uint8x16_t Full = vdupq_n_u8(255);
+	for (; i + 16 <= Count; i += 16)
+	{
+		// vld4 splits 16 BGRA pixels straight into one register per channel
+		const uint8x16x4_t Channels = vld4q_u8(BGRAPixels + i * 4);
+		if (R)
+			vst1q_u8(R + i, Channels.val[2]);
+		if (G)
+			vst1q_u8(G + i, Channels.val[1]);
+		if (B)
+			vst1q_u8(B + i, Channels.val[0]);
+		if (Base)
+			vst1q_u8(Base + i, vsubq_u8(vsubq_u8(vsubq_u8(Full, Channels.val[2]), Channels.val[1]), Channels.val[0]));
+	}
+#elif WOW_TILE_KERNELS_SSE2
+	const __m128i ByteMask = _mm_set1_epi32(0xFF);
+	const __m128i Full = _mm_set1_epi8(static_cast<char>(255));
+	for (; i + 16 <= Count; i += 16)
+	{
+		const __m128i *Source = reinterpret_cast<const __m128i *>(BGRAPixels + i * 4);
+		const __m128i P0 = _mm_loadu_si128(Source);
+		const __m128i P1 = _mm_loadu_si128(Source + 1);
+		const __m128i P2 = _mm_loadu_si128(Source + 2);
+		const __m128i P3 = _mm_loadu_si128(Source + 3);
+
+		// x86 is little endian, so a channel is one byte of every 32-bit lane. Values never exceed 255, so the signed 32->16 pack is lossless.
+		auto ExtractChannel = [&](const int Shift)
+		{
+			const __m128i Low = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(P0, Shift), ByteMask), _mm_and_si128(_mm_srli_epi32(P1, Shift), ByteMask));
+			const __m128i High = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(P2, Shift), ByteMask), _mm_and_si128(_mm_srli_epi32(P3, Shift), ByteMask));
+			return _mm_packus_epi16(Low, High);
+		};
+
+		const __m128i ChannelB = ExtractChannel(0);
+		const __m128i ChannelG = ExtractChannel(8);
+		const __m128i ChannelR = ExtractChannel(16);
+		if (R)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(R + i), ChannelR);
+		if (G)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(G + i), ChannelG);
+		if (B)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(B + i), ChannelB);
+		if (Base)
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(Base + i), _mm_sub_epi8(_mm_sub_epi8(_mm_sub_epi8(Full, ChannelR), ChannelG), ChannelB));
+	}
+#endif
+
+	DeinterleaveAlphamapWeightsScalar(BGRAPixels + i * 4, Count - i, R ? R + i : nullptr, G ? G + i : nullptr, B ? B + i : nullptr, Base ? Base + i : nullptr);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+// Tile assembly kernels. They only use standard C++ types, so they build outside the engine as well.
+
+#include <cstdint>
+
+/**
+ * Copies a 256x256 tile heightmap into a proxy heightmap that is ProxyWidth vertices wide, with tile vertex (0, 0) at
+ * ProxyOffset. Rows and columns before FirstY and FirstX are skipped, they are the border shared with the previous tile.
+ */
+void StitchTileHeightmap(const uint16_t *TileHeights, const int FirstX, const int FirstY, uint16_t *ProxyHeights, const int ProxyOffset, const int ProxyWidth);
+
+/**
+ * Splits the BGRA alphamap pixels of one 16x16 chunk of a tile into proxy weight planes, laid out as in
+ * StitchTileHeightmap. Weights holds the R, G, B and base planes, null for channels no layer of the chunk uses.
+ */
+void StitchChunkWeights(const uint8_t *BGRAPixels, const int ChunkIndex, const int FirstX, const int FirstY, uint8_t *const Weights[4], const int ProxyOffset, const int ProxyWidth);
+
+/**
+ * De-interleaves a run of BGRA alphamap pixels into landscape weight planes.
+ * Any plane may be null when no layer of the chunk uses that channel. Base is the implicit
+ * layer 255 - R - G - B, wrapped to 8 bits exactly like the per-pixel conversion it replaces.
+ */
+void DeinterleaveAlphamapWeights(const uint8_t *BGRAPixels, const int Count, uint8_t *R, uint8_t *G, uint8_t *B, uint8_t *Base);
+
+/** Scalar reference for DeinterleaveAlphamapWeights, also used for the tail that does not fill a vector */
+void DeinterleaveAlphamapWeightsScalar(const uint8_t *BGRAPixels, const int Count, uint8_t *R, uint8_t *G, uint8_t *B, uint8_t *Base);
@@ -0,0 +1,54 @@
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "EditorFramework/AssetImportData.h"
+#include "Engine/StaticMesh.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "WoWLandscapeImporter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWoWModelSidecarReimportTest, "WoWLandscapeImporter.Assets.ModelSidecarReimport", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWoWModelSidecarReimportTest::RunTest(const FString &Parameters)
+{
+	FWoWLandscapeImporterModule &Importer = FModuleManager::LoadModuleChecked<FWoWLandscapeImporterModule>(TEXT("WoWLandscapeImporter"));
+
+	// A model with its material data and materials, but no collision mesh
+	const FString SourceDirectory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("WoWModelSidecarReimport"));
+	const FString ModelPath = SourceDirectory / TEXT("sidecar_model.obj");
+	const TArray<FString> SidecarPaths = FWoWLandscapeImporterModule::GetModelSidecarPaths(ModelPath);
+	FFileHelper::SaveStringToFile(TEXT("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n"), *ModelPath);
+	FFileHelper::SaveStringToFile(TEXT("{\"fileType\":\"m2\"}"), *SidecarPaths[0]);
+	FFileHelper::SaveStringToFile(TEXT("newmtl mat_sidecar_model\n"), *SidecarPaths[1]);
+
+	// The mesh Interchange would have created, with the import data of its source file
+	const FString DestinationDirectory = TEXT("/Temp/WoWLandscapeImporterTests");
+	UPackage *Package = CreatePackage(*(DestinationDirectory / TEXT("sidecar_model")));
+	UStaticMesh *Mesh = NewObject<UStaticMesh>(Package, TEXT("sidecar_model"), RF_Public | RF_Standalone);
+	UAssetImportData *AssetImportData = NewObject<UAssetImportData>(Mesh);
+	Mesh->SetAssetImportData(AssetImportData);
+	FAssetRegistryModule::AssetCreated(Mesh);
+
+	// Import, then reimport into the same asset, which keeps its import data and only refreshes the source file
+	AssetImportData->Update(ModelPath);
+	FWoWLandscapeImporterModule::RecordModelSidecars(AssetImportData, ModelPath);
+	AssetImportData->AddFileName(ModelPath, 0);
+	FWoWLandscapeImporterModule::RecordModelSidecars(AssetImportData, ModelPath);
+
+	TestEqual(TEXT("Source files after a reimport"), AssetImportData->GetSourceFileCount(), 1 + SidecarPaths.Num());
+	TestTrue(TEXT("Unchanged model is reused after a reimport"), Importer.FindUnchangedAsset(DestinationDirectory, ModelPath, SidecarPaths).IsValid());
+
+	// A changed sidecar still invalidates the asset
+	FFileHelper::SaveStringToFile(TEXT("newmtl mat_sidecar_model_changed\n"), *SidecarPaths[1]);
+	TestFalse(TEXT("Model with a changed sidecar is not reused"), Importer.FindUnchangedAsset(DestinationDirectory, ModelPath, SidecarPaths).IsValid());
+
+	Mesh->ClearFlags(RF_Public | RF_Standalone);
+	Mesh->MarkAsGarbage();
+	FAssetRegistryModule::AssetDeleted(Mesh);
+	IFileManager::Get().DeleteDirectory(*SourceDirectory, false, true);
+	return true;
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "WoWLandscapeCore/WoWPlacementCsv.h"
+#include "WoWLandscapeCore/WoWPlacementKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWoWPlacementCsvReaderTest, "WoWLandscapeImporter.Kernels.PlacementCsvReader", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWoWPlacementCsvReaderTest::RunTest(const FString &Parameters)
+{
+	// BOM and header, CRLF and LF endings, an empty line, empty fields, a truncated row, a row past PlacementMaxFields
+	// and a last row without a line ending
+	static const char Csv[] =
+		"\xEF\xBB\xBFModelFile;PositionX;PositionY;PositionZ;RotationX;RotationY;RotationZ;RotationW;ScaleFactor;ModelId;Type;FileDataID\r\n"
+		"a.obj;1;2;3;4;5;6;7;8;9;m2;100\r\n"
+		"\r\n"
+		"b.obj;;2;;4;5;6;7;1\n"
+		"c.obj;1;2;3\r\n"
+		"d.obj;1;2;3;4;5;6;7;8;9;10;11;12;13;14;15;16;17;18;19;20\r\n"
+		"e.obj;1;2;3;4;5;6;7;0.5";
+
+	PlacementCsvReader Reader(Csv, sizeof(Csv) - 1);
+	PlacementCsvRow Row;
+	double Values[PlacementValueCount];
+	auto FieldEquals = [&Row](const int Index, const char *Expected)
+	{ return Index < Row.NumFields && Row.Fields[Index] == Expected; };
+
+	// The header is skipped, and neither the BOM nor \r end up in fields
+	if (!TestTrue(TEXT("First row read"), Reader.ReadRow(Row)))
+		return false;
+	TestEqual(TEXT("CRLF row field count"), Row.NumFields, 12);
+	TestTrue(TEXT("First field is the model path"), FieldEquals(0, "a.obj"));
+	TestTrue(TEXT("Last field has no \\r"), FieldEquals(11, "100"));
+	TestTrue(TEXT("CRLF row values"), ReadPlacementValues(Row, Values) && Values[0] == 1.0 && Values[7] == 8.0);
+
+	// The empty line is skipped, empty fields keep their column and read as 0
+	if (!TestTrue(TEXT("LF row read"), Reader.ReadRow(Row)))
+		return false;
+	TestTrue(TEXT("Empty line skipped"), FieldEquals(0, "b.obj"));
+	TestEqual(TEXT("LF row field count"), Row.NumFields, 9);
+	TestTrue(TEXT("Empty fields are kept"), FieldEquals(1, "") && FieldEquals(3, ""));
+	TestTrue(TEXT("Empty fields read as 0"), ReadPlacementValues(Row, Values) && Values[0] == 0.0 && Values[1] == 2.0 && Values[2] == 0.0 && Values[7] == 1.0);
+
+	// A truncated row is returned but has no values
+	if (!TestTrue(TEXT("Truncated row read"), Reader.ReadRow(Row)))
+		return false;
+	TestEqual(TEXT("Truncated row field count"), Row.NumFields, 4);
+	TestFalse(TEXT("Truncated row has no values"), ReadPlacementValues(Row, Values));
+
+	// Fields past PlacementMaxFields are not split out
+	if (!TestTrue(TEXT("Long row read"), Reader.ReadRow(Row)))
+		return false;
+	TestEqual(TEXT("Long row field count"), Row.NumFields, PlacementMaxFields);
+	TestTrue(TEXT("Last split field"), FieldEquals(PlacementMaxFields - 1, "15"));
+	TestTrue(TEXT("Long row values"), ReadPlacementValues(Row, Values) && Values[7] == 8.0);
+
+	// The last row ends at the end of the data
+	if (!TestTrue(TEXT("Unterminated row read"), Reader.ReadRow(Row)))
+		return false;
+	TestEqual(TEXT("Unterminated row field count"), Row.NumFields, 9);
+	TestTrue(TEXT("Unterminated row values"), ReadPlacementValues(Row, Values) && Values[7] == 0.5);
+	TestFalse(TEXT("No rows past the end"), Reader.ReadRow(Row));
+
+	// A file with only a header, or nothing at all, has no rows
+	static const char HeaderOnly[] = "\xEF\xBB\xBFModelFile;PositionX\r\n";
+	PlacementCsvReader HeaderReader(HeaderOnly, sizeof(HeaderOnly) - 1);
+	TestFalse(TEXT("Header only file has no rows"), HeaderReader.ReadRow(Row));
+	PlacementCsvReader EmptyReader(Csv, 0);
+	TestFalse(TEXT("Empty file has no rows"), EmptyReader.ReadRow(Row));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWoWParsePlacementNumberTest, "WoWLandscapeImporter.Kernels.ParsePlacementNumber", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWoWParsePlacementNumberTest::RunTest(const FString &Parameters)
+{
+	// Must match the FCString::Atod conversion of the FString fields it replaced, bit for bit, whatever the C locale
+	static const char *const Fields[] = {
+		"0", "-0", "1", "-1", "8", "0.5", "1.0000001", "17066.66656", "-16383.999999", "123456789.123456789",
+		"0.000001", "1e3", "-2.5E-4", "3.", ".25", "-.5", " 12.5", "\t7", "+2.5", "+-1", "12.5abc", "1e", "", "abc", "-", "+", "1,5"};
+	for (const char *Field : Fields)
+	{
+		const double Parsed = ParsePlacementNumber(Field);
+		const double Expected = FCString::Atod(UTF8_TO_TCHAR(Field));
+		if (FMemory::Memcmp(&Parsed, &Expected, sizeof(double)) != 0)
+			AddError(FString::Printf(TEXT("\"%s\" parsed as %.17g, FCString::Atod gives %.17g"), UTF8_TO_TCHAR(Field), Parsed, Expected));
+	}
+
+	// Random values as wow.export prints them
+	FRandomStream Random(0x574F57);
+	for (int i = 0; i < 10000; i++)
+	{
+		const FString Field = FString::Printf(TEXT("%.6f"), Random.FRandRange(-20000.0f, 20000.0f));
+		const double Parsed = ParsePlacementNumber(TCHAR_TO_UTF8(*Field));
+		const double Expected = FCString::Atod(*Field);
+		if (Parsed != Expected)
+		{
+			AddError(FString::Printf(TEXT("\"%s\" parsed as %.17g, FCString::Atod gives %.17g"), *Field, Parsed, Expected));
+			return false;
+		}
+	}
+	return !HasAnyErrors();
+}
+
+#endif
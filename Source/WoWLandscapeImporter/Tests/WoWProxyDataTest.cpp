@@ -0,0 +1,132 @@
+#include "LandscapeLayerInfoObject.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "WoWLandscapeImporter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWoWProxyStitchingTest, "WoWLandscapeImporter.Kernels.ProxyStitching", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWoWProxyStitchingTest::RunTest(const FString &Parameters)
+{
+	// A 2x2 proxy, as the importer built them before proxies were sized by ProxyTiles, so the original loop applies unchanged
+	static constexpr int ProxyTiles = 2;
+	static constexpr int ProxyWidth = ProxyTiles * 255 + 1;
+	static constexpr int NumLayerNames = 6;
+
+	FRandomStream Random(0x574F57);
+	TUniquePtr<FWoWLandscapeImporterModule> Importer = MakeUnique<FWoWLandscapeImporterModule>();
+	for (int i = 0; i < NumLayerNames; i++)
+	{
+		LayerMetadata &Metadata = Importer->LayerMetadataMap.Add(FName(*FString::Printf(TEXT("Layer%d"), i)));
+		Metadata.LayerInfo = NewObject<ULandscapeLayerInfoObject>();
+		Metadata.LayerInfo->LayerName = FName(*FString::Printf(TEXT("Layer%d"), i));
+	}
+
+	// Random pixels and layer assignments, including base layers, layers sharing an image channel and layers listed twice in
+	// a chunk. The last tile has no data.
+	Importer->TileGrid.SetNum(ProxyTiles);
+	for (int Row = 0; Row < ProxyTiles; Row++)
+	{
+		Importer->TileGrid[Row].SetNum(ProxyTiles);
+		for (int Column = 0; Column < ProxyTiles; Column++)
+		{
+			if (Row == ProxyTiles - 1 && Column == ProxyTiles - 1)
+				continue;
+
+			Tile &CurrentTile = Importer->TileGrid[Row][Column];
+			CurrentTile.HeightmapData.SetNumUninitialized(256 * 256 * sizeof(uint16));
+			for (uint8 &Byte : CurrentTile.HeightmapData)
+				Byte = (uint8)Random.RandRange(0, 255);
+			for (TArray64<uint8> &Alphamap : CurrentTile.AlphamapPNGs)
+			{
+				Alphamap.SetNumUninitialized(256 * 256 * 4);
+				for (uint8 &Byte : Alphamap)
+					Byte = (uint8)Random.RandRange(0, 255);
+			}
+			for (Chunk &CurrentChunk : CurrentTile.Chunks)
+			{
+				const int NumLayers = Random.RandRange(0, 5);
+				for (int i = 0; i < NumLayers; i++)
+					CurrentChunk.Layers.Add({FName(*FString::Printf(TEXT("Layer%d"), Random.RandRange(0, NumLayerNames - 1))), Random.RandRange(0, 1), Random.RandRange(-1, 2)});
+			}
+		}
+	}
+
+	// The per-pixel conversion CreateProxyData used before the stitching kernels, as the reference
+	TArray<uint16> ReferenceHeightmap;
+	ReferenceHeightmap.SetNumZeroed(ProxyWidth * ProxyWidth);
+	TMap<FName, TArray<uint8>> ReferenceLayers;
+	int CurrentRow = 0;
+	int TileY = 0;
+	for (int ProxyY = 0; ProxyY < ProxyWidth; ProxyY++)
+	{
+		if (TileY == 256)
+		{
+			CurrentRow++;
+			TileY = 1;
+		}
+
+		int ChunkY = TileY / 16;
+		int CurrentColumn = 0;
+		int TileX = 0;
+		for (int ProxyX = 0; ProxyX < ProxyWidth; ProxyX++)
+		{
+			if (TileX == 256)
+			{
+				CurrentColumn++;
+				TileX = 1;
+			}
+
+			int ProxyIndex = ProxyY * ProxyWidth + ProxyX;
+			const Tile &CurrentTile = Importer->TileGrid[CurrentRow][CurrentColumn];
+			if (!CurrentTile.HasImages())
+			{
+				TileX++;
+				continue;
+			}
+
+			int TileIndex = TileY * 256 + TileX;
+			ReferenceHeightmap[ProxyIndex] = CurrentTile.GetHeightmap()[TileIndex];
+
+			int ChunkX = TileX / 16;
+			int ChunkIndex = ChunkY * 16 + ChunkX;
+			for (const Layer &CurrentLayer : CurrentTile.Chunks[ChunkIndex].Layers)
+			{
+				FColor Pixel = CurrentTile.GetAlphamap(CurrentLayer.ImageIndex)[TileIndex];
+				TArray<uint8> &LayerData = ReferenceLayers.FindOrAdd(CurrentLayer.LayerName);
+				if (LayerData.Num() == 0)
+					LayerData.SetNumZeroed(ProxyWidth * ProxyWidth);
+
+				switch (CurrentLayer.ChannelIndex)
+				{
+				case -1: LayerData[ProxyIndex] = 255 - Pixel.R - Pixel.G - Pixel.B; break;
+				case 0: LayerData[ProxyIndex] = Pixel.R; break;
+				case 1: LayerData[ProxyIndex] = Pixel.G; break;
+				case 2: LayerData[ProxyIndex] = Pixel.B; break;
+				}
+			}
+			TileX++;
+		}
+		TileY++;
+	}
+
+	const TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> ProxyData = Importer->CreateProxyData(0, 0, ProxyTiles);
+	const TArray<uint16> &Heightmap = ProxyData.Get<0>();
+	const TArray<FLandscapeImportLayerInfo> &LayerInfos = ProxyData.Get<1>();
+
+	if (TestEqual(TEXT("Heightmap size"), Heightmap.Num(), ReferenceHeightmap.Num()))
+		TestTrue(TEXT("Heightmap matches the per-pixel conversion"), FMemory::Memcmp(Heightmap.GetData(), ReferenceHeightmap.GetData(), Heightmap.Num() * sizeof(uint16)) == 0);
+	TestEqual(TEXT("Number of layers"), LayerInfos.Num(), ReferenceLayers.Num());
+	for (const FLandscapeImportLayerInfo &LayerInfo : LayerInfos)
+	{
+		const TArray<uint8> *ReferenceData = ReferenceLayers.Find(LayerInfo.LayerName);
+		if (!ReferenceData)
+			AddError(FString::Printf(TEXT("Layer %s is not in the per-pixel conversion"), *LayerInfo.LayerName.ToString()));
+		else if (LayerInfo.LayerData.Num() != ReferenceData->Num() || FMemory::Memcmp(LayerInfo.LayerData.GetData(), ReferenceData->GetData(), ReferenceData->Num()) != 0)
+			AddError(FString::Printf(TEXT("Weights of layer %s differ from the per-pixel conversion"), *LayerInfo.LayerName.ToString()));
+	}
+	return !HasAnyErrors();
+}
+
+#endif
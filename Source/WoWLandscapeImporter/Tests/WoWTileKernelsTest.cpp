@@ -0,0 +1,64 @@
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "WoWLandscapeCore/WoWTileKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWoWDeinterleaveAlphamapWeightsTest, "WoWLandscapeImporter.Kernels.DeinterleaveAlphamapWeights", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FWoWDeinterleaveAlphamapWeightsTest::RunTest(const FString &Parameters)
+{
+	// Counts up to several vector widths with every tail length, bytes past Count must stay untouched
+	static constexpr int MaxCount = 70;
+	static constexpr int GuardBytes = 16;
+	static constexpr uint8 Guard = 0xCD;
+
+	FRandomStream Random(0x574F57);
+	TArray<uint8> Pixels;
+	Pixels.SetNumUninitialized(MaxCount * 4);
+	for (uint8 &Byte : Pixels)
+		Byte = (uint8)Random.RandRange(0, 255);
+	// Saturated pixels, so the base layer wraps below zero
+	FMemory::Memset(Pixels.GetData(), 255, 8 * 4);
+
+	uint8 Vector[4][MaxCount + GuardBytes];
+	uint8 Scalar[4][MaxCount + GuardBytes];
+	for (int Count = 0; Count <= MaxCount; Count++)
+	{
+		// Every combination of null planes
+		for (int PlaneMask = 0; PlaneMask < 16; PlaneMask++)
+		{
+			FMemory::Memset(Vector, Guard, sizeof(Vector));
+			FMemory::Memset(Scalar, Guard, sizeof(Scalar));
+			auto Plane = [PlaneMask](uint8 (&Planes)[4][MaxCount + GuardBytes], const int Channel)
+			{ return (PlaneMask & (1 << Channel)) ? Planes[Channel] : nullptr; };
+
+			DeinterleaveAlphamapWeights(Pixels.GetData(), Count, Plane(Vector, 0), Plane(Vector, 1), Plane(Vector, 2), Plane(Vector, 3));
+			DeinterleaveAlphamapWeightsScalar(Pixels.GetData(), Count, Plane(Scalar, 0), Plane(Scalar, 1), Plane(Scalar, 2), Plane(Scalar, 3));
+			if (FMemory::Memcmp(Vector, Scalar, sizeof(Vector)) != 0)
+			{
+				AddError(FString::Printf(TEXT("SIMD and scalar weights differ for %d pixels with plane mask %d"), Count, PlaneMask));
+				return false;
+			}
+			for (int Channel = 0; Channel < 4; Channel++)
+				for (int i = Count; i < MaxCount + GuardBytes; i++)
+					if (Vector[Channel][i] != Guard)
+					{
+						AddError(FString::Printf(TEXT("Plane %d written past %d pixels"), Channel, Count));
+						return false;
+					}
+		}
+	}
+
+	// The scalar path itself must match the per-pixel conversion it replaced
+	uint8 R, G, B, Base;
+	const uint8 Pixel[4] = {200, 100, 50, 0}; // BGRA
+	DeinterleaveAlphamapWeightsScalar(Pixel, 1, &R, &G, &B, &Base);
+	TestEqual(TEXT("R"), R, (uint8)50);
+	TestEqual(TEXT("G"), G, (uint8)100);
+	TestEqual(TEXT("B"), B, (uint8)200);
+	TestEqual(TEXT("Base wraps to 8 bits"), Base, (uint8)(255 - 50 - 100 - 200));
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "WoWImportManifest.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+static const int32 ManifestVersion = 2;
+
+static FGuid ParseGuid(const FString &GuidString)
+{
+	FGuid Guid;
+	FGuid::Parse(GuidString, Guid);
+	return Guid;
+}
+
+static FIntPoint GetTileCoordinates(const FJsonObject &Object)
+{
+	return FIntPoint((int32)Object.GetNumberField(TEXT("column")), (int32)Object.GetNumberField(TEXT("row")));
+}
+
+static TSharedRef<FJsonObject> MakeTileObject(const FIntPoint &Coordinates)
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetNumberField(TEXT("column"), Coordinates.X);
+	Object->SetNumberField(TEXT("row"), Coordinates.Y);
+	return Object;
+}
+
+FString FWoWImportManifest::GetManifestPath(const FString &LevelPackageName, const FString &MapName)
+{
+	// One directory per level, as the same map imported into two levels has two sets of actors
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WoWLandscapeImporter/Manifests"), LevelPackageName, MapName + TEXT(".json"));
+}
+
+FString FWoWImportManifest::ComputeFileKey(const FString &FilePath)
+{
+	return LexToString(FMD5Hash::HashFile(*FilePath));
+}
+
+bool FWoWImportManifest::Read(const FString &ManifestPath)
+{
+	FString ManifestString;
+	if (!FFileHelper::LoadFileToString(ManifestString, *ManifestPath))
+		return false;
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ManifestString);
+	int32 Version = 0;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetNumberField(TEXT("version"), Version) || Version != ManifestVersion)
+		return false;
+
+	MetadataKey = Root->GetStringField(TEXT("metadataKey"));
+	ProxyTiles = Root->GetIntegerField(TEXT("proxyTiles"));
+	LandscapeActorGuid = ParseGuid(Root->GetStringField(TEXT("landscape")));
+	RuntimeVirtualTextureVolumeGuid = ParseGuid(Root->GetStringField(TEXT("rvtVolume")));
+
+	const TArray<TSharedPtr<FJsonValue>> *Values = nullptr;
+	if (Root->TryGetArrayField(TEXT("tiles"), Values))
+		for (const TSharedPtr<FJsonValue> &Value : *Values)
+			TileKeys.Add(GetTileCoordinates(*Value->AsObject()), Value->AsObject()->GetStringField(TEXT("key")));
+
+	if (Root->TryGetArrayField(TEXT("proxies"), Values))
+		for (const TSharedPtr<FJsonValue> &Value : *Values)
+			ProxyActors.Add(GetTileCoordinates(*Value->AsObject()), ParseGuid(Value->AsObject()->GetStringField(TEXT("actor"))));
+
+	if (Root->TryGetArrayField(TEXT("placements"), Values))
+	{
+		for (const TSharedPtr<FJsonValue> &Value : *Values)
+		{
+			const TSharedPtr<FJsonObject> &Placement = Value->AsObject();
+			const FString TileName = Placement->GetStringField(TEXT("tile"));
+			PlacementKeys.Add(TileName, Placement->GetStringField(TEXT("key")));
+
+			TArray<FGuid> &Actors = PlacementActors.Add(TileName);
+			const TArray<TSharedPtr<FJsonValue>> *ActorValues = nullptr;
+			if (Placement->TryGetArrayField(TEXT("actors"), ActorValues))
+				for (const TSharedPtr<FJsonValue> &ActorValue : *ActorValues)
+					Actors.Add(ParseGuid(ActorValue->AsString()));
+		}
+	}
+	return true;
+}
+
+bool FWoWImportManifest::Write(const FString &ManifestPath) const
+{
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), ManifestVersion);
+	Root->SetStringField(TEXT("metadataKey"), MetadataKey);
+	Root->SetNumberField(TEXT("proxyTiles"), ProxyTiles);
+	Root->SetStringField(TEXT("landscape"), LandscapeActorGuid.ToString());
+	Root->SetStringField(TEXT("rvtVolume"), RuntimeVirtualTextureVolumeGuid.ToString());
+
+	TArray<TSharedPtr<FJsonValue>> TileValues;
+	for (const TPair<FIntPoint, FString> &TileKey : TileKeys)
+	{
+		TSharedRef<FJsonObject> TileObject = MakeTileObject(TileKey.Key);
+		TileObject->SetStringField(TEXT("key"), TileKey.Value);
+		TileValues.Add(MakeShared<FJsonValueObject>(TileObject));
+	}
+	Root->SetArrayField(TEXT("tiles"), TileValues);
+
+	TArray<TSharedPtr<FJsonValue>> ProxyValues;
+	for (const TPair<FIntPoint, FGuid> &ProxyActor : ProxyActors)
+	{
+		TSharedRef<FJsonObject> ProxyObject = MakeTileObject(ProxyActor.Key);
+		ProxyObject->SetStringField(TEXT("actor"), ProxyActor.Value.ToString());
+		ProxyValues.Add(MakeShared<FJsonValueObject>(ProxyObject));
+	}
+	Root->SetArrayField(TEXT("proxies"), ProxyValues);
+
+	TArray<TSharedPtr<FJsonValue>> PlacementValues;
+	for (const TPair<FString, FString> &PlacementKey : PlacementKeys)
+	{
+		TSharedRef<FJsonObject> PlacementObject = MakeShared<FJsonObject>();
+		PlacementObject->SetStringField(TEXT("tile"), PlacementKey.Key);
+		PlacementObject->SetStringField(TEXT("key"), PlacementKey.Value);
+
+		TArray<TSharedPtr<FJsonValue>> ActorValues;
+		if (const TArray<FGuid> *Actors = PlacementActors.Find(PlacementKey.Key))
+			for (const FGuid &ActorGuid : *Actors)
+				ActorValues.Add(MakeShared<FJsonValueString>(ActorGuid.ToString()));
+		PlacementObject->SetArrayField(TEXT("actors"), ActorValues);
+		PlacementValues.Add(MakeShared<FJsonValueObject>(PlacementObject));
+	}
+	Root->SetArrayField(TEXT("placements"), PlacementValues);
+
+	FString ManifestString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ManifestString);
+	return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(ManifestString, *ManifestPath);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Record of what the last import of a map into a level read and created, kept under Saved/WoWLandscapeImporter/Manifests.
+ * An incremental reimport compares the source file keys against it to find what changed, and resolves the actor
+ * GUIDs to find the proxies and placements those changes have to replace in the level.
+ */
+struct FWoWImportManifest
+{
+	/** Key of heightmap.json, its height range and sea level affect every tile and placement */
+	FString MetadataKey;
+
+	/** Tiles per proxy side the landscape was built with */
+	int ProxyTiles = 0;
+
+	FGuid LandscapeActorGuid;
+
+	/** Runtime virtual texture volume spawned with the landscape material, invalid if the import did not spawn one */
+	FGuid RuntimeVirtualTextureVolumeGuid;
+
+	/** Source files key of each tile (see FWoWTileCache::ComputeKey), by tile column and row */
+	TMap<FIntPoint, FString> TileKeys;
+
+	/** Streaming proxy actors, by the column and row of their first tile */
+	TMap<FIntPoint, FGuid> ProxyActors;
+
+	/** Key of each placement CSV, by the tile name that is also the root of its actor folder */
+	TMap<FString, FString> PlacementKeys;
+
+	/** Actors spawned from each placement CSV, by the same tile name */
+	TMap<FString, TArray<FGuid>> PlacementActors;
+
+	/** Manifest file of a map imported into the level package LevelPackageName, under Saved/WoWLandscapeImporter/Manifests */
+	static FString GetManifestPath(const FString &LevelPackageName, const FString &MapName);
+
+	/** MD5 of a source file, so a file that is touched or copied without changing keeps its key. Safe to call from worker threads. */
+	static FString ComputeFileKey(const FString &FilePath);
+
+	/** Returns false if the file is missing or not a manifest of this version */
+	bool Read(const FString &ManifestPath);
+
+	bool Write(const FString &ManifestPath) const;
+};
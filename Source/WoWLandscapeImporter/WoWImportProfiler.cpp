@@ -0,0 +1,104 @@
+#include "WoWImportProfiler.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "WoWLandscapeImporter.h"
+
+static double ToMegabytes(const uint64 Bytes)
+{
+	return Bytes / (1024.0 * 1024.0);
+}
+
+FWoWImportProfiler::FWoWImportProfiler(const FString &InImportName)
+	: ImportName(InImportName), ImportStartTime(FPlatformTime::Seconds())
+{
+}
+
+FWoWImportProfiler::~FWoWImportProfiler()
+{
+	// Closes the trace event of an import that stopped early
+	EndPhase();
+}
+
+void FWoWImportProfiler::BeginPhase(const TCHAR *PhaseName)
+{
+	if (bPhaseRunning)
+		EndPhase();
+
+#if CPUPROFILERTRACE_ENABLED
+	bTraceEventOpen = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+	if (bTraceEventOpen)
+		FCpuProfilerTrace::OutputBeginDynamicEvent(PhaseName);
+#endif
+	RunningPhase = PhaseName;
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+	PhaseStartTime = FPlatformTime::Seconds();
+	bPhaseRunning = true;
+}
+
+void FWoWImportProfiler::EndPhase(const int64 NumItems)
+{
+	if (!bPhaseRunning)
+		return;
+
+#if CPUPROFILERTRACE_ENABLED
+	if (bTraceEventOpen)
+		FCpuProfilerTrace::OutputEndEvent();
+	bTraceEventOpen = false;
+#endif
+	const double Seconds = FPlatformTime::Seconds() - PhaseStartTime;
+	const uint64 UsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	Phases.Add({RunningPhase, Seconds, NumItems, UsedPhysical});
+	PeakUsedPhysical = FMath::Max(PeakUsedPhysical, UsedPhysical);
+	bPhaseRunning = false;
+
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("%s: %.2f s"), *RunningPhase, Seconds);
+}
+
+void FWoWImportProfiler::Finish()
+{
+	EndPhase();
+
+	const double TotalSeconds = FPlatformTime::Seconds() - ImportStartTime;
+	// The platform peak covers the whole process lifetime, including work before this import, so it is reported separately
+	const uint64 ProcessPeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("import"), ImportName);
+	Report->SetStringField(TEXT("date"), FDateTime::Now().ToIso8601());
+	Report->SetNumberField(TEXT("totalSeconds"), TotalSeconds);
+	Report->SetNumberField(TEXT("peakUsedPhysicalMB"), ToMegabytes(PeakUsedPhysical));
+	Report->SetNumberField(TEXT("processPeakUsedPhysicalMB"), ToMegabytes(ProcessPeakUsedPhysical));
+
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Import summary for %s:"), *ImportName);
+	TArray<TSharedPtr<FJsonValue>> PhaseValues;
+	for (const PhaseStats &Phase : Phases)
+	{
+		const double ItemsPerSecond = Phase.Seconds > 0.0 ? Phase.NumItems / Phase.Seconds : 0.0;
+		UE_LOG(LogWoWLandscapeImporter, Log, TEXT("  %-22s %8.2f s %5.1f%% %8lld items %10.1f items/s %8.0f MB"), *Phase.Name, Phase.Seconds,
+			   TotalSeconds > 0.0 ? Phase.Seconds * 100.0 / TotalSeconds : 0.0, Phase.NumItems, ItemsPerSecond, ToMegabytes(Phase.UsedPhysical));
+
+		TSharedRef<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+		PhaseObject->SetStringField(TEXT("name"), Phase.Name);
+		PhaseObject->SetNumberField(TEXT("seconds"), Phase.Seconds);
+		PhaseObject->SetNumberField(TEXT("items"), (double)Phase.NumItems);
+		PhaseObject->SetNumberField(TEXT("itemsPerSecond"), ItemsPerSecond);
+		PhaseObject->SetNumberField(TEXT("usedPhysicalMB"), ToMegabytes(Phase.UsedPhysical));
+		PhaseValues.Add(MakeShared<FJsonValueObject>(PhaseObject));
+	}
+	Report->SetArrayField(TEXT("phases"), PhaseValues);
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Total import time: %.2f s, peak memory at phase boundaries: %.0f MB, process peak: %.0f MB"), TotalSeconds, ToMegabytes(PeakUsedPhysical), ToMegabytes(ProcessPeakUsedPhysical));
+
+	FString ReportString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportString);
+	FJsonSerializer::Serialize(Report, Writer);
+
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WoWLandscapeImporter/Reports"), FString::Printf(TEXT("%s_%s.json"), *ImportName, *FDateTime::Now().ToString()));
+	if (FFileHelper::SaveStringToFile(ReportString, *ReportPath))
+		UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Wrote import report to %s"), *ReportPath);
+}
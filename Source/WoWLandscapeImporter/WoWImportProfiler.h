@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Times the phases of one import. Each phase is a named CPU trace event for Unreal Insights, and records its wall time,
+ * item count and the process memory at its end. The import's peak memory is the largest of these samples, taken at the
+ * start and end of every phase. Finish logs a summary and writes it as a JSON report under Saved/WoWLandscapeImporter/Reports.
+ */
+class FWoWImportProfiler
+{
+public:
+	explicit FWoWImportProfiler(const FString &InImportName);
+	~FWoWImportProfiler();
+
+	/** Ends the running phase, if any, and starts PhaseName */
+	void BeginPhase(const TCHAR *PhaseName);
+
+	/** Ends the running phase, NumItems is what the phase processed and is used for its throughput */
+	void EndPhase(const int64 NumItems = 0);
+
+	/** Ends the running phase, then logs and writes the report */
+	void Finish();
+
+private:
+	struct PhaseStats
+	{
+		FString Name;
+		double Seconds;
+		int64 NumItems;
+		uint64 UsedPhysical;
+	};
+
+	FString ImportName;
+	double ImportStartTime;
+	double PhaseStartTime = 0.0;
+	bool bPhaseRunning = false;
+	bool bTraceEventOpen = false; // The trace channel can be toggled while a phase runs
+	FString RunningPhase;
+	TArray<PhaseStats> Phases;
+	uint64 PeakUsedPhysical = 0;
+};
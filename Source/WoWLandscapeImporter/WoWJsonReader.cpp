@@ -0,0 +1,252 @@
+#include "WoWJsonReader.h"
+#include "HAL/FileManager.h"
+#include "Serialization/JsonReader.h"
+
+typedef TJsonReader<UTF8CHAR> FWoWJsonStreamReader;
+
+/** Consumes the rest of a value whose first token has just been read */
+static void SkipValue(FWoWJsonStreamReader &Reader, const EJsonNotation Notation)
+{
+	if (Notation == EJsonNotation::ObjectStart)
+		Reader.SkipObject();
+	else if (Notation == EJsonNotation::ArrayStart)
+		Reader.SkipArray();
+}
+
+/** Calls ReadMember for each member of an object whose start has just been read; ReadMember must consume the value */
+static bool ReadObject(FWoWJsonStreamReader &Reader, TFunctionRef<void(const FString &Identifier, EJsonNotation Notation)> ReadMember)
+{
+	EJsonNotation Notation;
+	while (Reader.ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ObjectEnd)
+			return true;
+		ReadMember(Reader.GetIdentifier(), Notation);
+	}
+	return false;
+}
+
+/** Calls ReadElement for each element of an array whose start has just been read; ReadElement must consume the value */
+static bool ReadArray(FWoWJsonStreamReader &Reader, TFunctionRef<void(EJsonNotation Notation)> ReadElement)
+{
+	EJsonNotation Notation;
+	while (Reader.ReadNext(Notation))
+	{
+		if (Notation == EJsonNotation::ArrayEnd)
+			return true;
+		ReadElement(Notation);
+	}
+	return false;
+}
+
+static int ReadInt(FWoWJsonStreamReader &Reader, const EJsonNotation Notation)
+{
+	if (Notation == EJsonNotation::Number)
+		return (int)Reader.GetValueAsNumber();
+	SkipValue(Reader, Notation);
+	return 0;
+}
+
+static FString ReadString(FWoWJsonStreamReader &Reader, const EJsonNotation Notation)
+{
+	if (Notation == EJsonNotation::String)
+		return Reader.GetValueAsString();
+	SkipValue(Reader, Notation);
+	return FString();
+}
+
+/** Appends the elements of a number array as bytes, the encoding of vertex color arrays */
+static void ReadByteArray(FWoWJsonStreamReader &Reader, const EJsonNotation Notation, TArray<uint8> &OutBytes)
+{
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		SkipValue(Reader, Notation);
+		return;
+	}
+	ReadArray(Reader, [&Reader, &OutBytes](EJsonNotation ElementNotation)
+			  { OutBytes.Add((uint8)ReadInt(Reader, ElementNotation)); });
+}
+
+/** Calls ReadElement for each object of an array value, skipping anything else */
+static void ReadObjectArray(FWoWJsonStreamReader &Reader, const EJsonNotation Notation, TFunctionRef<void()> ReadElement)
+{
+	if (Notation != EJsonNotation::ArrayStart)
+	{
+		SkipValue(Reader, Notation);
+		return;
+	}
+	ReadArray(Reader, [&Reader, ReadElement](EJsonNotation ElementNotation)
+			  {
+				  if (ElementNotation == EJsonNotation::ObjectStart)
+					  ReadElement();
+				  else
+					  SkipValue(Reader, ElementNotation); });
+}
+
+static void ReadMaterial(FWoWJsonStreamReader &Reader, MaterialJson &OutMaterial)
+{
+	ReadObject(Reader, [&Reader, &OutMaterial](const FString &Identifier, EJsonNotation Notation)
+			   {
+				   if (Identifier == TEXT("shader"))
+					   OutMaterial.Shader = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("blendMode"))
+					   OutMaterial.BlendMode = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("blendingMode"))
+					   OutMaterial.BlendingMode = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("flags"))
+					   OutMaterial.Flags = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("texture1"))
+					   OutMaterial.Texture1 = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("texture2"))
+					   OutMaterial.Texture2 = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("texture3"))
+					   OutMaterial.Texture3 = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("color3"))
+					   OutMaterial.Color3 = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("flags3"))
+					   OutMaterial.Flags3 = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("runtimeData") && Notation == EJsonNotation::ArrayStart)
+					   ReadArray(Reader, [&Reader, &OutMaterial](EJsonNotation ElementNotation)
+								 { OutMaterial.RuntimeData.Add(ReadInt(Reader, ElementNotation)); });
+				   else
+					   SkipValue(Reader, Notation); });
+}
+
+static void ReadTexture(FWoWJsonStreamReader &Reader, TextureJson &OutTexture)
+{
+	ReadObject(Reader, [&Reader, &OutTexture](const FString &Identifier, EJsonNotation Notation)
+			   {
+				   if (Identifier == TEXT("fileDataID"))
+					   OutTexture.FileDataID = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("mtlName"))
+					   OutTexture.MtlName = ReadString(Reader, Notation);
+				   else
+					   SkipValue(Reader, Notation); });
+}
+
+static void ReadTextureUnit(FWoWJsonStreamReader &Reader, TextureUnitJson &OutTextureUnit)
+{
+	ReadObject(Reader, [&Reader, &OutTextureUnit](const FString &Identifier, EJsonNotation Notation)
+			   {
+				   if (Identifier == TEXT("materialIndex"))
+					   OutTextureUnit.MaterialIndex = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("flags"))
+					   OutTextureUnit.Flags = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("textureComboIndex"))
+					   OutTextureUnit.TextureComboIndex = ReadInt(Reader, Notation);
+				   else
+					   SkipValue(Reader, Notation); });
+}
+
+static void ReadGroupVertexColors(FWoWJsonStreamReader &Reader, TArray<uint8> &OutVertexColors)
+{
+	bool bHasColors2 = false;
+	TArray<uint8> Colors2;
+	TArray<uint8> LastVertexColours;
+	ReadObject(Reader, [&](const FString &Identifier, EJsonNotation Notation)
+			   {
+				   if (Identifier == TEXT("colors2") && Notation == EJsonNotation::ArrayStart)
+				   {
+					   bHasColors2 = true;
+					   ReadByteArray(Reader, Notation, Colors2);
+				   }
+				   else if (Identifier == TEXT("vertexColours") && Notation == EJsonNotation::ArrayStart)
+				   {
+					   // Only the last set is kept, as it is the one used by the two layer shaders
+					   ReadArray(Reader, [&Reader, &LastVertexColours](EJsonNotation SetNotation)
+								 {
+									 LastVertexColours.Reset();
+									 ReadByteArray(Reader, SetNotation, LastVertexColours); });
+				   }
+				   else
+					   SkipValue(Reader, Notation); });
+
+	OutVertexColors.Append(bHasColors2 ? Colors2 : LastVertexColours);
+}
+
+static void ReadAlphamapLayer(FWoWJsonStreamReader &Reader, AlphamapLayerJson &OutLayer)
+{
+	ReadObject(Reader, [&Reader, &OutLayer](const FString &Identifier, EJsonNotation Notation)
+			   {
+				   if (Identifier == TEXT("file"))
+					   OutLayer.File = ReadString(Reader, Notation);
+				   else if (Identifier == TEXT("heightFile"))
+					   OutLayer.HeightFile = ReadString(Reader, Notation);
+				   else if (Identifier == TEXT("effectID"))
+					   OutLayer.EffectID = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("chunkIndex"))
+					   OutLayer.ChunkIndex = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("imageIndex"))
+					   OutLayer.ImageIndex = ReadInt(Reader, Notation);
+				   else if (Identifier == TEXT("channelIndex"))
+					   OutLayer.ChannelIndex = ReadInt(Reader, Notation);
+				   else
+					   SkipValue(Reader, Notation); });
+}
+
+/** Opens FilePath and reads up to the start of its root object */
+static TSharedPtr<FWoWJsonStreamReader> OpenJsonObject(const FString &FilePath, TUniquePtr<FArchive> &OutFileReader)
+{
+	OutFileReader.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!OutFileReader)
+		return nullptr;
+
+	TSharedRef<FWoWJsonStreamReader> Reader = TJsonReaderFactory<UTF8CHAR>::Create(OutFileReader.Get());
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+		return nullptr;
+	return Reader;
+}
+
+bool FWoWJsonReader::ReadModel(const FString &FilePath, ModelJson &OutModel)
+{
+	TUniquePtr<FArchive> FileReader;
+	TSharedPtr<FWoWJsonStreamReader> ReaderPtr = OpenJsonObject(FilePath, FileReader);
+	if (!ReaderPtr)
+		return false;
+
+	FWoWJsonStreamReader &Reader = *ReaderPtr;
+	return ReadObject(Reader, [&Reader, &OutModel](const FString &Identifier, EJsonNotation Notation)
+					  {
+						  if (Identifier == TEXT("fileType"))
+							  OutModel.FileType = ReadString(Reader, Notation);
+						  else if (Identifier == TEXT("materials"))
+							  ReadObjectArray(Reader, Notation, [&Reader, &OutModel]()
+											  { ReadMaterial(Reader, OutModel.Materials.AddDefaulted_GetRef()); });
+						  else if (Identifier == TEXT("textures"))
+							  ReadObjectArray(Reader, Notation, [&Reader, &OutModel]()
+											  { ReadTexture(Reader, OutModel.Textures.AddDefaulted_GetRef()); });
+						  else if (Identifier == TEXT("textureCombos") && Notation == EJsonNotation::ArrayStart)
+							  ReadArray(Reader, [&Reader, &OutModel](EJsonNotation ElementNotation)
+										{ OutModel.TextureCombos.Add(ReadInt(Reader, ElementNotation)); });
+						  else if (Identifier == TEXT("skin") && Notation == EJsonNotation::ObjectStart)
+							  ReadObject(Reader, [&Reader, &OutModel](const FString &SkinIdentifier, EJsonNotation SkinNotation)
+										 {
+											 if (SkinIdentifier == TEXT("textureUnits"))
+												 ReadObjectArray(Reader, SkinNotation, [&Reader, &OutModel]()
+																 { ReadTextureUnit(Reader, OutModel.TextureUnits.AddDefaulted_GetRef()); });
+											 else
+												 SkipValue(Reader, SkinNotation); });
+						  else if (Identifier == TEXT("groups"))
+							  ReadObjectArray(Reader, Notation, [&Reader, &OutModel]()
+											  { ReadGroupVertexColors(Reader, OutModel.VertexColors); });
+						  else
+							  SkipValue(Reader, Notation); });
+}
+
+bool FWoWJsonReader::ReadAlphamapLayers(const FString &FilePath, TArray<AlphamapLayerJson> &OutLayers)
+{
+	TUniquePtr<FArchive> FileReader;
+	TSharedPtr<FWoWJsonStreamReader> ReaderPtr = OpenJsonObject(FilePath, FileReader);
+	if (!ReaderPtr)
+		return false;
+
+	FWoWJsonStreamReader &Reader = *ReaderPtr;
+	return ReadObject(Reader, [&Reader, &OutLayers](const FString &Identifier, EJsonNotation Notation)
+					  {
+						  if (Identifier == TEXT("layers"))
+							  ReadObjectArray(Reader, Notation, [&Reader, &OutLayers]()
+											  { ReadAlphamapLayer(Reader, OutLayers.AddDefaulted_GetRef()); });
+						  else
+							  SkipValue(Reader, Notation); });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Material entry of a model JSON. WMO materials use the shader fields, M2 materials use Flags and BlendingMode */
+struct MaterialJson
+{
+	int Shader = 0;
+	int BlendMode = 0;
+	int BlendingMode = 0;
+	int Flags = 0;
+	int Texture1 = 0;
+	int Texture2 = 0;
+	int Texture3 = 0;
+	int Color3 = 0;
+	int Flags3 = 0;
+	TArray<int> RuntimeData;
+};
+
+struct TextureJson
+{
+	int FileDataID = 0;
+	FString MtlName;
+};
+
+/** Entry of skin.textureUnits in an M2 JSON */
+struct TextureUnitJson
+{
+	int MaterialIndex = 0;
+	int Flags = 0;
+	int TextureComboIndex = 0;
+};
+
+/** The parts of a model JSON used by the importer */
+struct ModelJson
+{
+	FString FileType; // "wmo" or "m2"
+	TArray<MaterialJson> Materials;
+	TArray<TextureJson> Textures;
+	TArray<int> TextureCombos;
+	TArray<TextureUnitJson> TextureUnits;
+
+	// BGRA bytes per vertex of all WMO groups, from "colors2" or else the last "vertexColours" set of each group
+	TArray<uint8> VertexColors;
+};
+
+/** Entry of "layers" in a tile alphamap JSON */
+struct AlphamapLayerJson
+{
+	FString File;
+	FString HeightFile;
+	int EffectID = 0;
+	int ChunkIndex = 0;
+	int ImageIndex = 0;
+	int ChannelIndex = 0;
+};
+
+/**
+ * Streaming readers for the JSON files written by wow.export. The file is tokenized straight from disk and only the
+ * fields above are kept, so large WMO vertex color arrays never become a JSON DOM.
+ */
+class FWoWJsonReader
+{
+public:
+	/** Returns false if the file is missing or malformed */
+	static bool ReadModel(const FString &FilePath, ModelJson &OutModel);
+
+	/** Returns false if the file is missing or malformed */
+	static bool ReadAlphamapLayers(const FString &FilePath, TArray<AlphamapLayerJson> &OutLayers);
+};
@@ -1,17 +1,25 @@
 #include "WoWLandscapeImporter.h"
 #include "AssetImportTask.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "AssetToolsModule.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "Commands/WoWLandscapeImporterCommands.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/RuntimeVirtualTextureComponent.h"
 #include "DesktopPlatformModule.h"
 #include "Dom/JsonObject.h"
+#include "Editor.h"
 #include "EditorAssetLibrary.h"
+#include "EditorFramework/AssetImportData.h"
 #include "Engine/StaticMeshActor.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "Framework/Application/SlateApplication.h"
+#include "HAL/LowLevelMemTracker.h"
 #include "HAL/PlatformFilemanager.h"
 #include "IAssetTools.h"
 #include "IDesktopPlatform.h"
@@ -19,6 +27,7 @@
 #include "InterchangeGenericMaterialPipeline.h"
 #include "InterchangeGenericMeshPipeline.h"
 #include "InterchangeGenericTexturePipeline.h"
+#include "InterchangeHelper.h"
 #include "InterchangeManager.h"
 #include "InterchangeSourceData.h"
 #include "Landscape.h"
@@ -69,6 +78,7 @@
 #include "Materials/MaterialInstanceConstant.h"
 #include "MeshDescription.h"
 #include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
@@ -80,10 +90,21 @@
 #include "VT/RuntimeVirtualTextureVolume.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SSpinBox.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
+#include "WoWImportManifest.h"
+#include "WoWImportProfiler.h"
+#include "WoWLandscapeCore/WoWMeshKernels.h"
+#include "WoWLandscapeCore/WoWPlacementCsv.h"
+#include "WoWLandscapeCore/WoWPlacementKernels.h"
+#include "WoWLandscapeCore/WoWTileKernels.h"
+#include "WoWTileCache.h"
+#include "WorldPartition/WorldPartition.h"
+
+DEFINE_LOG_CATEGORY(LogWoWLandscapeImporter);
 
 static const FName WoWLandscapeImporterTabName("WoWLandscapeImporter");
 
@@ -97,6 +118,8 @@ void FWoWLandscapeImporterModule::StartupModule()
 
 	FWoWLandscapeImporterCommands::Register();
 
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
 	PluginCommands = MakeShareable(new FUICommandList);
 
 	PluginCommands->MapAction(
@@ -107,6 +130,8 @@ void FWoWLandscapeImporterModule::StartupModule()
 	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FWoWLandscapeImporterModule::RegisterMenus));
 
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(WoWLandscapeImporterTabName, FOnSpawnTab::CreateRaw(this, &FWoWLandscapeImporterModule::OnSpawnPluginTab)).SetDisplayName(LOCTEXT("FWoWLandscapeImporterTabTitle", "WoWLandscapeImporter")).SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	FEditorDelegates::PostSaveWorldWithContext.AddRaw(this, &FWoWLandscapeImporterModule::OnPostSaveWorld);
 }
 
 void FWoWLandscapeImporterModule::ShutdownModule()
@@ -123,6 +148,33 @@ void FWoWLandscapeImporterModule::ShutdownModule()
 	FWoWLandscapeImporterCommands::Unregister();
 
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(WoWLandscapeImporterTabName);
+
+	FEditorDelegates::PostSaveWorldWithContext.RemoveAll(this);
+}
+
+void FWoWLandscapeImporterModule::OnPostSaveWorld(UWorld *World, FObjectPostSaveContext ObjectSaveContext)
+{
+	// The commandlet writes the manifest itself, after the actor packages of the level are saved as well
+	if (!IsRunningCommandlet() && PendingManifest.IsSet() && World == PendingManifestWorld.Get() && ObjectSaveContext.SaveSucceeded())
+		WritePendingManifest();
+}
+
+bool FWoWLandscapeImporterModule::WritePendingManifest()
+{
+	if (!PendingManifest.IsSet())
+		return true;
+
+	// The path is only resolved now, as saving a new level gives it its package name
+	const UWorld *World = PendingManifestWorld.Get();
+	const FString ManifestPath = World ? FWoWImportManifest::GetManifestPath(World->GetPackage()->GetName(), PendingManifestMapName) : FString();
+	const bool bWritten = World && PendingManifest->Write(ManifestPath);
+	if (bWritten)
+		UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Wrote the import manifest %s"), *ManifestPath);
+	else
+		UE_LOG(LogWoWLandscapeImporter, Warning, TEXT("Could not write the import manifest of %s"), *PendingManifestMapName);
+	PendingManifest.Reset();
+	PendingManifestWorld.Reset();
+	return bWritten;
 }
 
 TSharedRef<SDockTab> FWoWLandscapeImporterModule::OnSpawnPluginTab(const FSpawnTabArgs &SpawnTabArgs)
@@ -136,6 +188,34 @@ TSharedRef<SDockTab> FWoWLandscapeImporterModule::OnSpawnPluginTab(const FSpawnT
 																																																																																																																																																																																																																																																																						   .OnValueChanged_Lambda([this](int NewValue)
 																																																																																																																																																																																																																																																																												  { WPGridSize = NewValue; })
 																																																																																																																																																																																																																																																																						   .MinDesiredWidth(60.0f)]] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionCheckBox(LOCTEXT("StreamTilesLabel", "Stream tiles during proxy build"), &bStreamTiles)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionCheckBox(LOCTEXT("UseTileCacheLabel", "Cache decoded tiles"), &bUseTileCache)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionCheckBox(LOCTEXT("InstanceModelsLabel", "Instance repeated models"), &bInstanceModels)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionCheckBox(LOCTEXT("IncrementalReimportLabel", "Only rebuild what changed since the last import"), &bIncrementalReimport)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionCheckBox(LOCTEXT("SkipExistingAssetsLabel", "Reuse unchanged textures and meshes"), &bSkipExistingAssets)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionSpinBox(LOCTEXT("InstancingThresholdLabel", "Instancing threshold:"), &InstancingThreshold, 2, 1000)] +
+					  SVerticalBox::Slot()
+						  .AutoHeight()
+						  .Padding(0, 2)
+							  [MakeOptionSpinBox(LOCTEXT("MaxConcurrentImportsLabel", "Concurrent model imports:"), &MaxConcurrentImports, 1, 256)] +
 					  SVerticalBox::Slot()
 						  .AutoHeight()
 						  .Padding(0, 10)
@@ -146,6 +226,36 @@ TSharedRef<SDockTab> FWoWLandscapeImporterModule::OnSpawnPluginTab(const FSpawnT
 								   .ColorAndOpacity(FSlateColor(FLinearColor::White))]]];
 }
 
+TSharedRef<SWidget> FWoWLandscapeImporterModule::MakeOptionCheckBox(const FText &Label, bool *Option)
+{
+	return SNew(SCheckBox)
+		.IsChecked_Lambda([Option]()
+						  { return *Option ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+		.OnCheckStateChanged_Lambda([Option](ECheckBoxState NewState)
+									{ *Option = NewState == ECheckBoxState::Checked; })
+			[SNew(STextBlock).Text(Label).Font(FCoreStyle::GetDefaultFontStyle("Regular", 12))];
+}
+
+TSharedRef<SWidget> FWoWLandscapeImporterModule::MakeOptionSpinBox(const FText &Label, int *Option, int MinValue, int MaxValue)
+{
+	return SNew(SHorizontalBox) +
+		   SHorizontalBox::Slot()
+			   .AutoWidth()
+			   .VAlign(VAlign_Center)
+			   .Padding(0, 0, 10, 0)
+				   [SNew(STextBlock).Text(Label).Font(FCoreStyle::GetDefaultFontStyle("Regular", 12))] +
+		   SHorizontalBox::Slot()
+			   .AutoWidth()
+				   [SNew(SSpinBox<int>)
+						.MinValue(MinValue)
+						.MaxValue(MaxValue)
+						.Value_Lambda([Option]()
+									  { return *Option; })
+						.OnValueChanged_Lambda([Option](int NewValue)
+											   { *Option = NewValue; })
+						.MinDesiredWidth(60.0f)];
+}
+
 FReply FWoWLandscapeImporterModule::OnImportButtonClicked()
 {
 	// Clear any previous status message
@@ -167,7 +277,7 @@ FReply FWoWLandscapeImporterModule::OnImportButtonClicked()
 
 		if (bFolderSelected && !DirectoryPath.IsEmpty())
 		{
-			ImportLandscape();
+			ImportLandscape(DirectoryPath);
 		}
 		else if (!bFolderSelected)
 		{
@@ -195,8 +305,17 @@ FReply FWoWLandscapeImporterModule::OnImportButtonClicked()
 	return FReply::Handled();
 }
 
-void FWoWLandscapeImporterModule::ImportLandscape()
+bool FWoWLandscapeImporterModule::ImportLandscape(const FString &MapDirectory)
 {
+	DirectoryPath = MapDirectory;
+	LLM_SCOPE_BYNAME(TEXT("WoWLandscapeImporter"));
+	FWoWImportProfiler Profiler(FPaths::GetCleanFilename(DirectoryPath));
+	Profiler.BeginPhase(TEXT("File discovery"));
+
+	// Existing assets are found through the asset registry, which a commandlet has not scanned yet
+	if (bSkipExistingAssets)
+		IAssetRegistry::GetChecked().ScanPathsSynchronous({TEXT("/Game/Assets/WoWExport")});
+
 	TArray<FString> HeightmapFiles;
 	TArray<FString> AlphamapPNGs;
 	TArray<FString> AlphamapJSONs;
@@ -226,15 +345,27 @@ void FWoWLandscapeImporterModule::ImportLandscape()
 	if (HeightmapFiles.IsEmpty() || AlphamapPNGs.IsEmpty() || AlphamapJSONs.IsEmpty() || CSVFiles.IsEmpty() || FoliageJSONs.IsEmpty())
 	{
 		UpdateStatusMessage(TEXT("Missing either: Heightmap files, Alphamap PNGs, Alphamap JSONs, CSV files, or Foliage JSONs"), true);
+		return false;
 	}
 	else
 	{
+		Profiler.EndPhase(HeightmapFiles.Num() + AlphamapPNGs.Num() + AlphamapJSONs.Num() + CSVFiles.Num() + FoliageFiles.Num() + FoliageJSONs.Num());
+		// With streaming, pixels are decoded during the proxy build and this phase only reads the layer tables. Cached tiles
+		// are mapped during the proxy build either way.
+		Profiler.BeginPhase(bStreamTiles ? TEXT("Tile layer read") : TEXT("Tile decode"));
+		UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Importing %s (%d tiles, %d worker threads)"), *DirectoryPath, HeightmapFiles.Num(), FTaskGraphInterface::Get().GetNumWorkerThreads());
+
 		double Zscale = 0.0, SeaLevelOffset = 0.0;
 		int TileColumns = 0, TileRows = 0;
 
 		// Read heightmap metadata JSON and extract heightmap range
 		FString MetadataPath = FPaths::Combine(DirectoryPath, TEXT("heightmaps/heightmap.json"));
 		TSharedPtr<FJsonObject> JsonObject = LoadJsonObject(MetadataPath);
+		if (!JsonObject.IsValid())
+		{
+			UpdateStatusMessage(FString::Printf(TEXT("Could not read %s"), *MetadataPath), true);
+			return false;
+		}
 		TSharedPtr<FJsonObject> HeightDataObject = JsonObject->GetObjectField(TEXT("height_data"));
 
 		double Range = HeightDataObject->GetNumberField(TEXT("range"));
@@ -249,89 +380,224 @@ void FWoWLandscapeImporterModule::ImportLandscape()
 		TileColumns = TileDataObject->GetNumberField(TEXT("columns"));
 		TileRows = TileDataObject->GetNumberField(TEXT("rows"));
 
+		// WPGridSize is the number of components per proxy side, and each 510 quad component spans 2x2 tiles
+		const int ProxyTiles = 2 * WPGridSize;
+
+		TileGrid.Empty();
 		TileGrid.SetNum(TileRows);
 		for (int Row = 0; Row < TileRows; Row++)
 			TileGrid[Row].SetNum(TileColumns);
 
-		TMap<int, TTuple<FString, FString, int>> TexturePaths;
-		// Collect filedata and metadata
-		for (int i = 0; i < HeightmapFiles.Num(); i++)
+		const FString MapName = FPaths::GetCleanFilename(DirectoryPath);
+		UWorld *World = GEditor->GetEditorWorldContext().World();
+
+		// An incremental reimport needs the manifest of the last import, made with the same metadata and proxy size, and its landscape still in the level
+		const FString ManifestPath = FWoWImportManifest::GetManifestPath(World->GetPackage()->GetName(), MapName);
+		FWoWImportManifest PreviousManifest;
+		FWoWImportManifest Manifest;
+		Manifest.MetadataKey = FWoWImportManifest::ComputeFileKey(MetadataPath);
+		Manifest.ProxyTiles = ProxyTiles;
+
+		// Loaded actors are indexed once, the others are loaded from their world partition descriptors when they are looked up
+		UWorldPartition *WorldPartition = World->GetWorldPartition();
+		TMap<FGuid, AActor *> ActorsByGuid;
+		TArray<FWorldPartitionReference> ActorReferences;
+		ALandscape *Landscape = nullptr;
+
+		// An import of this map that is not saved yet is what the level holds, rather than the manifest on disk
+		bool bHasPreviousManifest = false;
+		if (PendingManifest.IsSet() && PendingManifestMapName == MapName && PendingManifestWorld.Get() == World)
+		{
+			PreviousManifest = PendingManifest.GetValue();
+			bHasPreviousManifest = true;
+		}
+		else
+			bHasPreviousManifest = PreviousManifest.Read(ManifestPath);
+
+		if (bHasPreviousManifest)
 		{
-			TArray<FString> NameParts;
-			FPaths::GetBaseFilename(HeightmapFiles[i]).ParseIntoArray(NameParts, TEXT("_"), true);
-			Tile NewTile;
+			for (TActorIterator<AActor> It(World); It; ++It)
+				ActorsByGuid.Add(It->GetActorGuid(), *It);
+			if (bIncrementalReimport && PreviousManifest.MetadataKey == Manifest.MetadataKey && PreviousManifest.ProxyTiles == ProxyTiles)
+				Landscape = Cast<ALandscape>(FindManifestActor(WorldPartition, PreviousManifest.LandscapeActorGuid, ActorsByGuid, ActorReferences));
+		}
+		const bool bIncremental = Landscape != nullptr;
+		if (bIncrementalReimport && !bIncremental)
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("No matching manifest or landscape from a previous import of %s, importing everything"), *MapName);
 
-			NewTile.Column = FCString::Atoi(*NameParts[1]);
-			NewTile.Row = FCString::Atoi(*NameParts[2]);
+		// A full import replaces what the previous import of this map left in the level, instead of adding a second landscape next to it
+		if (bHasPreviousManifest && !bIncremental)
+		{
+			TArray<FGuid> PreviousActors;
+			for (const TPair<FString, TArray<FGuid>> &PlacementActors : PreviousManifest.PlacementActors)
+				PreviousActors.Append(PlacementActors.Value);
+			for (const TPair<FIntPoint, FGuid> &ProxyActor : PreviousManifest.ProxyActors)
+				PreviousActors.Add(ProxyActor.Value);
+			PreviousActors.Add(PreviousManifest.RuntimeVirtualTextureVolumeGuid);
+			PreviousActors.Add(PreviousManifest.LandscapeActorGuid); // Last, once its proxies are unregistered
+			const int NumDestroyed = DestroyManifestActors(WorldPartition, PreviousActors, ActorsByGuid);
+			if (NumDestroyed > 0)
+				UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Removed %d actors of the previous import of %s"), NumDestroyed, *MapName);
+		}
 
-			// Collect heightmap PNG data
-			FString HeightmapPath = FPaths::Combine(DirectoryPath, TEXT("heightmaps/"), HeightmapFiles[i]);
-			LoadImageData(HeightmapPath, ERGBFormat::Gray, 16, NewTile.HeightmapData);
+		// Source file keys validate cache entries and let the next incremental reimport find what changed. Hashing reads every
+		// source file a second time, so it only happens when one of them is enabled. Keys left empty count as changed next time.
+		const bool bComputeTileKeys = bUseTileCache || bIncrementalReimport;
 
-			// Collect alphamaps and their PNG data
-			for (int j = 0; j < 2; j++)
-			{
-				FString FileName = (j == 0) ? AlphamapPNGs[i] : AlphamapPNGs[i].LeftChop(4) + TEXT("_1.png");
-				FString AlphamapPath = FPaths::Combine(DirectoryPath, TEXT("alphamaps/"), FileName);
-				LoadImageData(AlphamapPath, ERGBFormat::BGRA, 8, NewTile.AlphamapPNGs[j]);
-			}
+		// Decode stage: every tile is independent, so the PNG and JSON loads are spread across the worker threads
+		TArray<FIntPoint> TileCoordinates;
+		TileCoordinates.SetNum(HeightmapFiles.Num());
+		TArray<FString> TileKeys;
+		TileKeys.SetNum(HeightmapFiles.Num());
+		ParallelFor(HeightmapFiles.Num(), [&](int32 i)
+					{
+						TArray<FString> NameParts;
+						FPaths::GetBaseFilename(HeightmapFiles[i]).ParseIntoArray(NameParts, TEXT("_"), true);
+						Tile NewTile;
 
-			// Collect alphamap JSON data
-			FString JsonPath = FPaths::Combine(DirectoryPath, TEXT("alphamaps/"), AlphamapJSONs[i]);
-			TSharedPtr<FJsonObject> AlphamapJsonObject = LoadJsonObject(JsonPath);
-			TArray<TSharedPtr<FJsonValue>> Layers = AlphamapJsonObject->GetArrayField(TEXT("layers"));
+						NewTile.Column = FCString::Atoi(*NameParts[1]);
+						NewTile.Row = FCString::Atoi(*NameParts[2]);
+						TileCoordinates[i] = FIntPoint(NewTile.Column, NewTile.Row);
 
-			for (const TSharedPtr<FJsonValue> &LayerValue : Layers)
-			{
-				TSharedPtr<FJsonObject> LayerObject = LayerValue->AsObject();
-				FString TexPathBase = LayerObject->GetStringField(TEXT("file")).Replace(TEXT("\\"), TEXT("/"));
-				FString TexPathHeight = LayerObject->GetStringField(TEXT("heightFile")).Replace(TEXT("\\"), TEXT("/"));
-				TexturePaths.FindOrAdd(LayerObject->GetNumberField(TEXT("effectID")), TTuple<FString, FString, int>(TexPathBase, TexPathHeight, 0)).Get<2>()++;
-
-				int ChunkIndex = LayerObject->GetNumberField(TEXT("chunkIndex"));
-				Layer NewLayer;
-				NewLayer.LayerName = FName(FPaths::GetBaseFilename(TexPathBase));
-				NewLayer.ImageIndex = LayerObject->GetIntegerField(TEXT("imageIndex"));
-				NewLayer.ChannelIndex = LayerObject->GetIntegerField(TEXT("channelIndex"));
-				NewTile.Chunks[ChunkIndex].Layers.Add(NewLayer);
-			}
-			TileGrid[NewTile.Row][NewTile.Column] = NewTile;
+						// Collect heightmap and alphamap files, their pixel data is decoded here unless it is streamed in during the proxy build
+						NewTile.HeightmapPath = FPaths::Combine(DirectoryPath, TEXT("heightmaps/"), HeightmapFiles[i]);
+						for (int j = 0; j < 2; j++)
+						{
+							FString FileName = (j == 0) ? AlphamapPNGs[i] : AlphamapPNGs[i].LeftChop(4) + TEXT("_1.png");
+							NewTile.AlphamapPaths[j] = FPaths::Combine(DirectoryPath, TEXT("alphamaps/"), FileName);
+						}
+						NewTile.AlphamapJsonPath = FPaths::Combine(DirectoryPath, TEXT("alphamaps/"), AlphamapJSONs[i]);
+
+						// Layers come from the tile cache when it is up to date, otherwise from the alphamap JSON. The same key goes into the manifest.
+						if (bComputeTileKeys)
+							TileKeys[i] = FWoWTileCache::ComputeKey(NewTile);
+						if (bUseTileCache)
+						{
+							NewTile.CachePath = FWoWTileCache::GetCachePath(MapName, HeightmapFiles[i]);
+							NewTile.CacheKey = TileKeys[i];
+						}
+						const bool bCachedLayers = bUseTileCache && FWoWTileCache::ReadLayers(NewTile);
+						if (!bCachedLayers)
+							LoadTileLayers(NewTile);
+
+						// Without streaming, tiles missing from the cache are decoded here. Cached tiles are mapped once their proxy row
+						// is built, so a map with thousands of tiles never holds all of its cache files open. An incremental reimport
+						// leaves all decoding to the proxy build, which only loads the tiles of changed proxies.
+						if (!bStreamTiles && !bCachedLayers && !bIncremental)
+							LoadTileImages(NewTile);
+						TileGrid[NewTile.Row][NewTile.Column] = MoveTemp(NewTile);
+					});
+
+		// Layer texture references are merged in file order, so TexturePaths matches a sequential load
+		TMap<int, TTuple<FString, FString, int>> TexturePaths;
+		for (const FIntPoint &Coordinates : TileCoordinates)
+			for (const TPair<int, TTuple<FString, FString, int>> &TexturePath : TileGrid[Coordinates.Y][Coordinates.X].TexturePaths)
+				TexturePaths.FindOrAdd(TexturePath.Key, TTuple<FString, FString, int>(TexturePath.Value.Get<0>(), TexturePath.Value.Get<1>(), 0)).Get<2>() += TexturePath.Value.Get<2>();
+
+		// Proxies to rebuild are those holding a tile that is new, changed or gone since the last import
+		for (int i = 0; i < TileCoordinates.Num(); i++)
+			Manifest.TileKeys.Add(TileCoordinates[i], TileKeys[i]);
+		TSet<FIntPoint> ChangedProxies;
+		TSet<int> ChangedProxyRows;
+		if (bIncremental)
+		{
+			for (const TPair<FIntPoint, FString> &TileKey : Manifest.TileKeys)
+				if (PreviousManifest.TileKeys.FindRef(TileKey.Key) != TileKey.Value)
+					ChangedProxies.Add(TileKey.Key / ProxyTiles * ProxyTiles);
+			for (const TPair<FIntPoint, FString> &TileKey : PreviousManifest.TileKeys)
+				if (!Manifest.TileKeys.Contains(TileKey.Key))
+					ChangedProxies.Add(TileKey.Key / ProxyTiles * ProxyTiles);
+			for (const FIntPoint &Proxy : ChangedProxies)
+				ChangedProxyRows.Add(Proxy.Y);
 		}
+		Profiler.EndPhase(HeightmapFiles.Num());
 
-		UMaterial *ModelMaterial = CreateModelMaterial(TEXT("M_Model"));
-		ImportLayers(TexturePaths, FoliageFiles, FoliageJSONs, ModelMaterial);
+		Profiler.BeginPhase(TEXT("Layer texture import"));
 
-		ALandscape *Landscape = GEditor->GetEditorWorldContext().World()->SpawnActor<ALandscape>();
-		Landscape->SetActorLabel(*FPaths::GetCleanFilename(DirectoryPath));
-		Landscape->SetActorScale3D(FVector(48768.f / 255.f, 48768.f / 255.f, Zscale)); // X/Y scale is 48,768 cm ÷ 255 quads. Standard WoW ADT (map tile) is 533.333 yards (48,768 cm) wide.
+		UMaterial *ModelMaterial = CreateModelMaterial(TEXT("M_Model"));
+		// The layers, and with them the landscape material, are only rebuilt when a layer has no assets yet
+		const bool bRebuildLayers = !bIncremental || !LoadExistingLayers(TexturePaths);
+		const int NumFailedLayers = bRebuildLayers ? ImportLayers(TexturePaths, FoliageFiles, FoliageJSONs, ModelMaterial) : 0;
+		Profiler.EndPhase(bRebuildLayers ? TexturePaths.Num() : 0);
 
-		FGuid LandscapeGuid = FGuid::NewGuid();
-		Landscape->SetLandscapeGuid(LandscapeGuid);
+		Profiler.BeginPhase(TEXT("Proxy build"));
 
-		// Heightmaps are 256x256, but each landscape component should be 510x510
-		Landscape->ComponentSizeQuads = 510;
-		Landscape->SubsectionSizeQuads = 255;
-		Landscape->NumSubsections = 2;
+		if (!bIncremental)
+		{
+			Landscape = World->SpawnActor<ALandscape>();
+			Landscape->SetActorLabel(*FPaths::GetCleanFilename(DirectoryPath));
+			Landscape->SetActorScale3D(FVector(48768.f / 255.f, 48768.f / 255.f, Zscale)); // X/Y scale is 48,768 cm ÷ 255 quads. Standard WoW ADT (map tile) is 533.333 yards (48,768 cm) wide.
+			Landscape->SetLandscapeGuid(FGuid::NewGuid());
+
+			// Heightmaps are 256x256, but each landscape component should be 510x510
+			Landscape->ComponentSizeQuads = 510;
+			Landscape->SubsectionSizeQuads = 255;
+			Landscape->NumSubsections = 2;
+		}
+		const FGuid LandscapeGuid = Landscape->GetLandscapeGuid();
+		Manifest.LandscapeActorGuid = Landscape->GetActorGuid();
 
 		ULandscapeInfo *LandscapeInfo = Landscape->CreateLandscapeInfo();
+		if (bIncremental)
+		{
+			// Changed proxies are built again from scratch, the others are kept as they are
+			TArray<FGuid> ChangedProxyActors;
+			for (const TPair<FIntPoint, FGuid> &ProxyActor : PreviousManifest.ProxyActors)
+			{
+				if (ChangedProxies.Contains(ProxyActor.Key))
+					ChangedProxyActors.Add(ProxyActor.Value);
+				else
+					Manifest.ProxyActors.Add(ProxyActor.Key, ProxyActor.Value);
+			}
+			const int NumDestroyed = DestroyManifestActors(WorldPartition, ChangedProxyActors, ActorsByGuid);
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("%d proxies changed since the last import, removed %d of them"), ChangedProxies.Num(), NumDestroyed);
+		}
 		{
-			FScopedSlowTask SlowTask(TileRows * TileColumns, LOCTEXT("ImportingWoWLandscape", "Importing WoW Landscape..."));
+			FScopedSlowTask SlowTask(FMath::DivideAndRoundUp(TileRows, ProxyTiles) * FMath::DivideAndRoundUp(TileColumns, ProxyTiles), LOCTEXT("ImportingWoWLandscape", "Importing WoW Landscape..."));
 			SlowTask.MakeDialog();
 
-			for (int Row = 0; Row < TileRows; Row += 2)
+			double ProxyAssemblyTime = 0.0;
+			int NumProxies = 0;
+
+			// When streaming, the next row of proxies is decoded on worker threads while the current one is built
+			TFuture<void> NextTileRows;
+			// An incremental reimport only decodes the tiles of changed proxies
+			const TSet<FIntPoint> *ProxiesToLoad = bIncremental ? &ChangedProxies : nullptr;
+			auto IsProxyRowNeeded = [bIncremental, &ChangedProxyRows](const int Row)
+			{ return !bIncremental || ChangedProxyRows.Contains(Row); };
+			if (bStreamTiles && IsProxyRowNeeded(0))
+				LoadTileRows(0, ProxyTiles, ProxiesToLoad);
+
+			for (int Row = 0; Row < TileRows; Row += ProxyTiles)
 			{
-				for (int Column = 0; Column < TileColumns; Column += 2)
+				if (bStreamTiles)
+				{
+					if (NextTileRows.IsValid())
+						NextTileRows.Wait();
+					if (Row + ProxyTiles < TileRows && IsProxyRowNeeded(Row + ProxyTiles))
+						NextTileRows = Async(EAsyncExecution::ThreadPool, [this, NextRow = Row + ProxyTiles, ProxyTiles, ProxiesToLoad]()
+											 { LoadTileRows(NextRow, ProxyTiles, ProxiesToLoad); });
+				}
+				else if (IsProxyRowNeeded(Row))
+					LoadTileRows(Row, ProxyTiles, ProxiesToLoad);
+
+				for (int Column = 0; Column < TileColumns; Column += ProxyTiles)
 				{
 					SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("ImportingProxy", "Importing Proxy at (Row {1}), (Column {0})"), Column, Row));
-					int RightTile = FMath::Min(Column + 1, TileColumns - 1);
-					int BottomTile = FMath::Min(Row + 1, TileRows - 1);
-					if (TileGrid[Row][Column].HeightmapData.Num() == 0 &&
-						TileGrid[BottomTile][Column].HeightmapData.Num() == 0 &&
-						TileGrid[Row][RightTile].HeightmapData.Num() == 0 &&
-						TileGrid[BottomTile][RightTile].HeightmapData.Num() == 0)
+					if (bIncremental && !ChangedProxies.Contains(FIntPoint(Column, Row)))
 						continue;
 
-					TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> ProxyData = CreateProxyData(Row, Column);
+					bool bHasTiles = false;
+					for (int TileRow = Row; TileRow < FMath::Min(Row + ProxyTiles, TileRows) && !bHasTiles; TileRow++)
+						for (int TileColumn = Column; TileColumn < FMath::Min(Column + ProxyTiles, TileColumns) && !bHasTiles; TileColumn++)
+							bHasTiles = TileGrid[TileRow][TileColumn].HasImages();
+					if (!bHasTiles)
+						continue;
+
+					const double ProxyStartTime = FPlatformTime::Seconds();
+					TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> ProxyData = CreateProxyData(Row, Column, ProxyTiles);
+					ProxyAssemblyTime += FPlatformTime::Seconds() - ProxyStartTime;
+					NumProxies++;
 
 					// Create a LandscapeStreamingProxy actor for the current tiles
 					ALandscapeStreamingProxy *StreamingProxy = GEditor->GetEditorWorldContext().World()->SpawnActor<ALandscapeStreamingProxy>();
@@ -346,165 +612,387 @@ void FWoWLandscapeImporterModule::ImportLandscape()
 
 					uint32 MinY = Row * 255;
 					uint32 MinX = Column * 255;
-					uint32 MaxY = MinY + 510;
-					uint32 MaxX = MinX + 510;
+					uint32 MaxY = MinY + ProxyTiles * 255;
+					uint32 MaxX = MinX + ProxyTiles * 255;
 					StreamingProxy->Import(FGuid::NewGuid(), MinX, MinY, MaxX, MaxY, 2, 255, HeightDataPerLayer, nullptr, MaterialLayerDataPerLayer, ELandscapeImportAlphamapType::Additive);
 
 					StreamingProxy->SetLandscapeGuid(LandscapeGuid);
 					LandscapeInfo->RegisterActor(StreamingProxy);
+					Manifest.ProxyActors.Add(FIntPoint(Column, Row), StreamingProxy->GetActorGuid());
 				}
+
+				// Every proxy touching these tile rows has been built
+				ReleaseTileRows(Row, ProxyTiles);
 			}
+			// Pixel data is not needed past the proxy build, this also closes any mapped tile cache files
+			ReleaseTileRows(0, TileRows);
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Proxy assembly: %.2f s for %d proxies (%.1f ms per proxy)"), ProxyAssemblyTime, NumProxies, NumProxies > 0 ? ProxyAssemblyTime * 1000.0 / NumProxies : 0.0);
+			Profiler.EndPhase(NumProxies);
 		}
-		CreateLandscapeMaterial(Landscape);
+
+		Profiler.BeginPhase(TEXT("Material build"));
+		if (bIncremental)
+			Manifest.RuntimeVirtualTextureVolumeGuid = PreviousManifest.RuntimeVirtualTextureVolumeGuid;
+		if (bRebuildLayers)
+			if (AActor *RVTVolume = CreateLandscapeMaterial(Landscape))
+				Manifest.RuntimeVirtualTextureVolumeGuid = RVTVolume->GetActorGuid();
+		Profiler.EndPhase(bRebuildLayers ? LayerMetadataMap.Num() : 0);
+
+		Profiler.BeginPhase(TEXT("CSV parse"));
 
 		TArray<ActorData> ActorsArray;
+		ActorDedupIndex ActorsIndex;
+		TMap<int, TArray<WMOChildPlacement>> WMOPlacementCache;
+		// Doodads repeat across every tile, so model paths are resolved and checked once per path and placements only keep the model index
+		TArray<FString> ModelFullPaths;
+		TMap<FString, int> ModelIndices;
+		auto InternModelPath = [&ModelFullPaths, &ModelIndices](const FString &FullPath)
+		{
+			if (const int *ModelIndex = ModelIndices.Find(FullPath))
+				return *ModelIndex;
+			// Empty or invalid obj files get no index, their placements are skipped
+			const int ModelIndex = IFileManager::Get().FileSize(*FullPath) >= 1000 ? ModelFullPaths.Add(FullPath) : INDEX_NONE;
+			ModelIndices.Add(FullPath, ModelIndex);
+			return ModelIndex;
+		};
+		// Model index of every distinct relative path of the map's placement CSVs
+		PlacementPathTable ModelPathTable;
+		TArray<int> PathModelIndices;
+		TArray<FString> TileNames;
+		TileNames.Reserve(CSVFiles.Num());
+		// Placement files are keyed by content for the next incremental reimport, hashing them is spread across the worker threads
+		TArray<FString> PlacementKeys;
+		PlacementKeys.SetNum(CSVFiles.Num());
+		if (bIncrementalReimport)
+			ParallelFor(CSVFiles.Num(), [this, &CSVFiles, &PlacementKeys](int32 i)
+						{ PlacementKeys[i] = FWoWImportManifest::ComputeFileKey(FPaths::Combine(DirectoryPath, CSVFiles[i])); });
+
 		// First pass: parse CSV files and collect actor data
-		for (const FString &CSVFile : CSVFiles)
+		for (int CSVIndex = 0; CSVIndex < CSVFiles.Num(); CSVIndex++)
 		{
+			const FString &CSVFile = CSVFiles[CSVIndex];
 			FString CSVPath = FPaths::Combine(DirectoryPath, CSVFile);
-			FString CSVContent;
-			if (FFileHelper::LoadFileToString(CSVContent, *CSVPath))
+			const int TileIndex = TileNames.Add(CSVFile.Replace(TEXT("_ModelPlacementInformation.csv"), TEXT("")).Replace(TEXT("adt_"), TEXT("")));
+			Manifest.PlacementKeys.Add(TileNames[TileIndex], PlacementKeys[CSVIndex]);
+			TArray64<uint8> CSVBuffer;
+			if (FFileHelper::LoadFileToArray(CSVBuffer, *CSVPath))
 			{
-				TArray<FString> CSVLines;
-				CSVContent.ParseIntoArrayLines(CSVLines);
-				CSVLines.RemoveAt(0);
-
-				for (const FString &Line : CSVLines)
+				// Rows are tokenized in place in the file buffer
+				PlacementCsvReader Reader(reinterpret_cast<const char *>(CSVBuffer.GetData()), CSVBuffer.Num());
+				PlacementCsvRow Row;
+				while (Reader.ReadRow(Row))
 				{
-					TArray<FString> CSVFields;
-					Line.ParseIntoArray(CSVFields, TEXT(";"), false);
+					double Values[PlacementValueCount];
+					if (Row.NumFields < 11 || !ReadPlacementValues(Row, Values))
+						continue; // Truncated row
+
+					const int PathIndex = ModelPathTable.Intern(Row.Fields[0]);
+					if (PathIndex == PathModelIndices.Num())
+					{
+						const FUTF8ToTCHAR RelativePath(Row.Fields[0].data(), (int32)Row.Fields[0].size());
+						PathModelIndices.Add(InternModelPath(FPaths::ConvertRelativePathToFull(DirectoryPath, FString(RelativePath.Length(), RelativePath.Get()))));
+					}
+					if (PathModelIndices[PathIndex] == INDEX_NONE)
+						continue; // Skip empty obj files
 
 					ActorData Actor;
-					Actor.ModelPath = FPaths::ConvertRelativePathToFull(DirectoryPath, CSVFields[0]);
-					Actor.Tile = CSVFile.Replace(TEXT("_ModelPlacementInformation.csv"), TEXT("")).Replace(TEXT("adt_"), TEXT(""));
+					Actor.ModelIndex = PathModelIndices[PathIndex];
+					Actor.TileIndex = TileIndex;
+
+					const PlacementTransform Transform = ConvertMapPlacement(Values, Row.Fields[10] == "gobj", SeaLevelOffset);
 
-					if (CSVFields[10] == TEXT("gobj"))
+					Actor.Position = FVector(Transform.Position[0], Transform.Position[1], Transform.Position[2]);
+					if (Transform.bHasQuat)
 					{
-						// Game object has data relative to the center of the map, so we need to offset by 17066.66656f
-						Actor.Position = FVector(
-							(17066.66656f - FCString::Atod(*CSVFields[2])) * 91.44f,
-							(17066.66656f - FCString::Atod(*CSVFields[1])) * 91.44f,
-							FCString::Atod(*CSVFields[3]) * 91.44f + SeaLevelOffset);
-						// Create quaternion from game object rotation data
-						FQuat GOBJQuat(
-							-FCString::Atod(*CSVFields[7]), // X
-							FCString::Atod(*CSVFields[6]),	// Y
-							-FCString::Atod(*CSVFields[5]), // Z
-							FCString::Atod(*CSVFields[4])	// W
-						);
-						Actor.Rotation = GOBJQuat.Rotator();
+						// Game objects are placed by quaternion
+						Actor.Rotation = FQuat(Transform.Quat[0], Transform.Quat[1], Transform.Quat[2], Transform.Quat[3]).Rotator();
 						Actor.Rotation.Yaw = Actor.Rotation.Yaw - 90;
 						Actor.Rotation.Roll = Actor.Rotation.Roll - 180;
 					}
 					else
-					{
-						// Extract position data and convert to centimeters(from yards)
-						Actor.Position = FVector(
-							FCString::Atod(*CSVFields[1]) * 91.44f,
-							FCString::Atod(*CSVFields[3]) * 91.44f,
-							FCString::Atod(*CSVFields[2]) * 91.44f + SeaLevelOffset);
-						// Extract rotation data and convert to Unreal's coordinate system
-						Actor.Rotation = FRotator(
-							-FCString::Atod(*CSVFields[4]),
-							90 - FCString::Atod(*CSVFields[5]),
-							FCString::Atod(*CSVFields[6]));
-					}
+						Actor.Rotation = FRotator(Transform.Rotation[0], Transform.Rotation[1], Transform.Rotation[2]);
+					Actor.Scale = Transform.Scale;
 
-					Actor.Scale = FCString::Atod(*CSVFields[8]);
+					if (ActorsIndex.Contains(ActorsArray, Actor))
+						continue; // Skip duplicate placements
 
-					if (IFileManager::Get().FileSize(*Actor.ModelPath) < 1000 || (ActorsArray.Contains(Actor)))
-						continue; // Skip empty or duplicate obj files
-
-					if (Actor.ModelPath.Contains(TEXT("/wmo/")))
+					if (ModelFullPaths[Actor.ModelIndex].Contains(TEXT("/wmo/")))
 					{
-						FString WMOCSV = FPaths::GetBaseFilename(Actor.ModelPath) + TEXT("_ModelPlacementInformation.csv");
-						FString WMOCSVPath = FPaths::GetPath(Actor.ModelPath);
-						FString WMOCSVContent;
-						if (FFileHelper::LoadFileToString(WMOCSVContent, *FPaths::Combine(WMOCSVPath, WMOCSV)))
+						// Big WMOs are referenced from many tiles, so their own placement CSV is only parsed once per import
+						const TArray<WMOChildPlacement> *ChildPlacements = WMOPlacementCache.Find(Actor.ModelIndex);
+						if (!ChildPlacements)
 						{
-							TArray<FString> WMOCSVLines;
-							WMOCSVContent.ParseIntoArrayLines(WMOCSVLines);
-							WMOCSVLines.RemoveAt(0);
+							// Parsing interns new model paths, so the WMO path is copied out of ModelFullPaths first
+							const FString WMOModelPath = ModelFullPaths[Actor.ModelIndex];
+							ChildPlacements = &WMOPlacementCache.Add(Actor.ModelIndex, ParseWMOPlacements(WMOModelPath, InternModelPath));
+						}
 
-							for (const FString &WMOCSVLine : WMOCSVLines)
-							{
-								TArray<FString> WMOCSVFields;
-								WMOCSVLine.ParseIntoArray(WMOCSVFields, TEXT(";"), false);
-
-								ActorData WMOActor;
-								WMOActor.ModelPath = FPaths::ConvertRelativePathToFull(WMOCSVPath, WMOCSVFields[0]);
-								WMOActor.Tile = Actor.Tile;
-								WMOActor.ParentWMO = FPaths::GetBaseFilename(Actor.ModelPath);
-
-								if (IFileManager::Get().FileSize(*WMOActor.ModelPath) < 1000)
-									continue; // Skip empty or invalid obj files
-
-								WMOActor.Position = FVector(
-									FCString::Atod(*WMOCSVFields[1]) * 91.44f,
-									-FCString::Atod(*WMOCSVFields[2]) * 91.44f,
-									FCString::Atod(*WMOCSVFields[3]) * 91.44f);
-								WMOActor.Position = Actor.Rotation.RotateVector(WMOActor.Position);
-								WMOActor.Position += Actor.Position;
-
-								// Create quaternion from WMO actors rotation data
-								FQuat WMOQuat(
-									-FCString::Atod(*WMOCSVFields[5]), // X
-									FCString::Atod(*WMOCSVFields[6]),  // Y
-									-FCString::Atod(*WMOCSVFields[7]), // Z
-									FCString::Atod(*WMOCSVFields[4])   // W
-								);
-
-								// Combine WMO rotation with WMO actor's rotation and make euler angles
-								WMOQuat = Actor.Rotation.Quaternion() * WMOQuat;
-								WMOActor.Rotation = WMOQuat.Rotator();
-
-								WMOActor.Scale = FCString::Atod(*WMOCSVFields[8]);
-								ActorsArray.Add(WMOActor);
-							}
+						const FQuat ActorQuat = Actor.Rotation.Quaternion();
+						for (const WMOChildPlacement &Child : *ChildPlacements)
+						{
+							ActorData WMOActor;
+							WMOActor.ModelIndex = Child.ModelIndex;
+							WMOActor.TileIndex = Actor.TileIndex;
+							WMOActor.ParentModelIndex = Actor.ModelIndex;
+							WMOActor.Position = Actor.Rotation.RotateVector(Child.Position) + Actor.Position;
+
+							// Combine WMO rotation with WMO actor's rotation and make euler angles
+							WMOActor.Rotation = (ActorQuat * Child.Rotation).Rotator();
+							WMOActor.Scale = Child.Scale;
+							ActorsIndex.Add(ActorsArray, WMOActor);
 						}
 					}
-					ActorsArray.Add(Actor);
+					ActorsIndex.Add(ActorsArray, Actor);
 				}
 			}
 		}
 
-		// Sort by filename
+		// Every CSV is parsed so duplicates resolve as in a full import, then only the placements of changed CSVs are kept and their old actors replaced
+		if (bIncremental)
+		{
+			TSet<FString> ChangedPlacements;
+			for (const TPair<FString, FString> &PlacementKey : Manifest.PlacementKeys)
+				if (PreviousManifest.PlacementKeys.FindRef(PlacementKey.Key) != PlacementKey.Value)
+					ChangedPlacements.Add(PlacementKey.Key);
+
+			TArray<FGuid> ChangedActors;
+			for (const TPair<FString, TArray<FGuid>> &PlacementActors : PreviousManifest.PlacementActors)
+			{
+				if (ChangedPlacements.Contains(PlacementActors.Key) || !Manifest.PlacementKeys.Contains(PlacementActors.Key))
+					ChangedActors.Append(PlacementActors.Value);
+				else
+					Manifest.PlacementActors.Add(PlacementActors.Key, PlacementActors.Value);
+			}
+			const int NumDestroyed = DestroyManifestActors(WorldPartition, ChangedActors, ActorsByGuid);
+			ActorsArray.RemoveAll([&ChangedPlacements, &TileNames](const ActorData &Actor)
+								  { return !ChangedPlacements.Contains(TileNames[Actor.TileIndex]); });
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("%d placement files changed since the last import, replacing %d actors with %d placements"), ChangedPlacements.Num(), NumDestroyed, ActorsArray.Num());
+		}
+
+		// Sort by model, so the placements of a model form one contiguous range
 		ActorsArray.Sort([](const ActorData &A, const ActorData &B)
-						 { return A.ModelPath < B.ModelPath; });
+						 { return A.ModelIndex < B.ModelIndex; });
 
-		// Extract model paths from ActorsArray
+		// Extract the models still placed from ActorsArray
 		TArray<FString> ModelPaths;
-		for (const ActorData &Actor : ActorsArray)
-			ModelPaths.Add(Actor.ModelPath);
+		for (int Actor = 0; Actor < ActorsArray.Num(); Actor++)
+			if (Actor == 0 || ActorsArray[Actor].ModelIndex != ActorsArray[Actor - 1].ModelIndex)
+				ModelPaths.Add(ModelFullPaths[ActorsArray[Actor].ModelIndex]);
 
-		TArray<UStaticMesh *> ImportedModels = ImportModels(ModelPaths, ModelMaterial);
+		Profiler.EndPhase(ActorsArray.Num());
 
-		int Model = 0;
-		// Second pass: spawn static mesh actors for each model and set their properties
-		for (int Actor = 0; Actor < ActorsArray.Num(); Actor++)
+		Profiler.BeginPhase(TEXT("Model import"));
+		TMap<FString, UStaticMesh *> ImportedModels = ImportModels(ModelPaths, ModelMaterial);
+		const int NumFailedModels = ModelPaths.Num() - ImportedModels.Num(); // ImportModels leaves ModelPaths without duplicates
+		Profiler.EndPhase(ImportedModels.Num());
+
+		Profiler.BeginPhase(TEXT("Actor spawn"));
+
+		int NumInstancedActors = 0;
+		int NumFailedPlacements = 0;
+		// Second pass: spawn actors for each model. ActorsArray is sorted by model, so the placements of a model form one contiguous range
+		for (int FirstActor = 0; FirstActor < ActorsArray.Num();)
 		{
-			if (Actor != 0 && ActorsArray[Actor].ModelPath != ActorsArray[Actor - 1].ModelPath)
-				Model++;
+			const FString &ModelPath = ModelFullPaths[ActorsArray[FirstActor].ModelIndex];
+			UStaticMesh *Mesh = ImportedModels.FindRef(ModelPath);
+			int EndActor = FirstActor + 1;
+			while (EndActor < ActorsArray.Num() && ActorsArray[EndActor].ModelIndex == ActorsArray[FirstActor].ModelIndex)
+				EndActor++;
 
-			// Spawn static mesh actor
-			AStaticMeshActor *ModelActor = GEditor->GetEditorWorldContext().World()->SpawnActor<AStaticMeshActor>();
-			ModelActor->SetActorLabel(FPaths::GetBaseFilename(ActorsArray[Actor].ModelPath));
+			if (!Mesh)
+			{
+				// Placements of a model that failed to import are left out, an empty key makes the next incremental reimport retry their tiles
+				for (int Actor = FirstActor; Actor < EndActor; Actor++)
+					Manifest.PlacementKeys.FindOrAdd(TileNames[ActorsArray[Actor].TileIndex]).Reset();
+				NumFailedPlacements += EndActor - FirstActor;
+				FirstActor = EndActor;
+				continue;
+			}
 
-			// Set folder path based on tile and parent WMO (if applicable)
-			FString FolderPath = ActorsArray[Actor].ParentWMO.IsEmpty() ? ActorsArray[Actor].Tile : FString::Printf(TEXT("%s/%s"), *ActorsArray[Actor].Tile, *ActorsArray[Actor].ParentWMO);
-			ModelActor->SetFolderPath(FName(*FolderPath));
+			// Group placements by folder, which is the tile and the parent WMO (if applicable)
+			TMap<FIntPoint, TArray<int>> FolderToActors;
+			for (int Actor = FirstActor; Actor < EndActor; Actor++)
+				FolderToActors.FindOrAdd(FIntPoint(ActorsArray[Actor].TileIndex, ActorsArray[Actor].ParentModelIndex)).Add(Actor);
+			FirstActor = EndActor;
 
-			ModelActor->GetStaticMeshComponent()->SetStaticMesh(ImportedModels[Model]);
+			const FString ModelName = FPaths::GetBaseFilename(ModelPath);
+			for (const TPair<FIntPoint, TArray<int>> &Folder : FolderToActors)
+			{
+				const FString &TileName = TileNames[Folder.Key.X];
+				const FString FolderPath = Folder.Key.Y == INDEX_NONE ? TileName : FString::Printf(TEXT("%s/%s"), *TileName, *FPaths::GetBaseFilename(ModelFullPaths[Folder.Key.Y]));
+				TArray<FGuid> &PlacementActors = Manifest.PlacementActors.FindOrAdd(TileName);
+				if (bInstanceModels && Folder.Value.Num() >= InstancingThreshold)
+				{
+					AActor *InstanceActor = SpawnInstancedModelActor(Mesh, ModelName, FolderPath, ActorsArray, Folder.Value);
+					PlacementActors.Add(InstanceActor->GetActorGuid());
+					NumInstancedActors++;
+					continue;
+				}
 
-			// We need to calculate the correct positions, as they are stored as yards in csv.
-			ModelActor->SetActorLocation(ActorsArray[Actor].Position);
-			ModelActor->SetActorRotation(ActorsArray[Actor].Rotation);
-			ModelActor->SetActorScale3D(FVector(ActorsArray[Actor].Scale * 91.44f));
+				const FName FolderName(*FolderPath);
+				for (int Actor : Folder.Value)
+				{
+					// Spawn static mesh actor
+					AStaticMeshActor *ModelActor = GEditor->GetEditorWorldContext().World()->SpawnActor<AStaticMeshActor>();
+					ModelActor->SetActorLabel(ModelName);
+					ModelActor->SetFolderPath(FolderName);
+
+					ModelActor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+
+					// We need to calculate the correct positions, as they are stored as yards in csv.
+					ModelActor->SetActorLocation(ActorsArray[Actor].Position);
+					ModelActor->SetActorRotation(ActorsArray[Actor].Rotation);
+					ModelActor->SetActorScale3D(FVector(ActorsArray[Actor].Scale * 91.44f));
+					PlacementActors.Add(ModelActor->GetActorGuid());
+				}
+			}
+		}
+		if (bInstanceModels)
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Spawned %d instanced mesh actors for %d placements"), NumInstancedActors, ActorsArray.Num());
+		Profiler.EndPhase(ActorsArray.Num());
+
+		// The manifest only becomes valid with the level, so it is written once the level is saved
+		PendingManifest = MoveTemp(Manifest);
+		PendingManifestMapName = MapName;
+		PendingManifestWorld = World;
+		Profiler.Finish();
+
+		if (NumFailedLayers > 0 || NumFailedModels > 0 || NumFailedPlacements > 0)
+		{
+			UpdateStatusMessage(FString::Printf(TEXT("Imported %s with failures: %d layer textures or foliage meshes, %d models and %d placements"), *MapName, NumFailedLayers, NumFailedModels, NumFailedPlacements), true);
+			return false;
 		}
 	}
+	return true;
 }
 
-void FWoWLandscapeImporterModule::ImportLayers(TMap<int, TTuple<FString, FString, int>> &TexturePaths, TArray<FString> &FoliageFiles, TArray<FString> &FoliageJSONs, UMaterial *ModelMaterial)
+AActor *FWoWLandscapeImporterModule::SpawnInstancedModelActor(UStaticMesh *Mesh, const FString &ModelName, const FString &FolderPath, const TArray<ActorData> &Actors, const TArray<int> &ActorIndices)
+{
+	TArray<FTransform> InstanceTransforms;
+	FVector Center = FVector::ZeroVector;
+	for (int Actor : ActorIndices)
+	{
+		InstanceTransforms.Add(FTransform(Actors[Actor].Rotation, Actors[Actor].Position, FVector(Actors[Actor].Scale * 91.44f)));
+		Center += Actors[Actor].Position;
+	}
+
+	// One actor per mesh and folder, placed at the center of its instances so World Partition assigns it to the right cell
+	AActor *InstanceActor = GEditor->GetEditorWorldContext().World()->SpawnActor<AActor>();
+	InstanceActor->SetActorLabel(FString::Printf(TEXT("%s_Instances"), *ModelName));
+	InstanceActor->SetFolderPath(FName(*FolderPath));
+
+	UHierarchicalInstancedStaticMeshComponent *InstanceComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceActor, TEXT("Instances"));
+	InstanceComponent->SetMobility(EComponentMobility::Static);
+	InstanceComponent->SetStaticMesh(Mesh);
+	InstanceActor->SetRootComponent(InstanceComponent);
+	InstanceActor->AddInstanceComponent(InstanceComponent);
+	InstanceComponent->RegisterComponent();
+
+	InstanceActor->SetActorLocation(Center / ActorIndices.Num());
+	InstanceComponent->AddInstances(InstanceTransforms, false, true);
+	return InstanceActor;
+}
+
+AActor *FWoWLandscapeImporterModule::FindManifestActor(UWorldPartition *WorldPartition, const FGuid &ActorGuid, const TMap<FGuid, AActor *> &LoadedActors, TArray<FWorldPartitionReference> &References)
+{
+	if (AActor *Actor = LoadedActors.FindRef(ActorGuid))
+		return Actor;
+
+	// Actors of world partition cells that are not loaded in the editor are only known by their descriptors
+	if (WorldPartition && WorldPartition->GetActorDescInstance(ActorGuid))
+	{
+		FWorldPartitionReference &Reference = References.Emplace_GetRef(WorldPartition, ActorGuid);
+		return Reference.IsLoaded() ? Reference->GetActor() : nullptr;
+	}
+	return nullptr;
+}
+
+int FWoWLandscapeImporterModule::DestroyManifestActors(UWorldPartition *WorldPartition, const TArray<FGuid> &ActorGuids, const TMap<FGuid, AActor *> &ActorsByGuid)
+{
+	// Keeps the actors loaded here alive until they are destroyed
+	TArray<FWorldPartitionReference> References;
+	int NumDestroyed = 0;
+	for (const FGuid &ActorGuid : ActorGuids)
+	{
+		AActor *Actor = FindManifestActor(WorldPartition, ActorGuid, ActorsByGuid, References);
+		if (!IsValid(Actor))
+			continue; // Deleted by hand since the last import
+
+		if (ALandscapeStreamingProxy *StreamingProxy = Cast<ALandscapeStreamingProxy>(Actor))
+			if (ULandscapeInfo *LandscapeInfo = StreamingProxy->GetLandscapeInfo())
+				LandscapeInfo->UnregisterActor(StreamingProxy);
+		Actor->GetWorld()->EditorDestroyActor(Actor, true);
+		NumDestroyed++;
+	}
+	return NumDestroyed;
+}
+
+TArray<WMOChildPlacement> FWoWLandscapeImporterModule::ParseWMOPlacements(const FString &WMOModelPath, TFunctionRef<int(const FString &)> InternModelPath)
+{
+	TArray<WMOChildPlacement> ChildPlacements;
+	FString WMOCSV = FPaths::GetBaseFilename(WMOModelPath) + TEXT("_ModelPlacementInformation.csv");
+	FString WMOCSVPath = FPaths::GetPath(WMOModelPath);
+	TArray64<uint8> WMOCSVBuffer;
+	if (FFileHelper::LoadFileToArray(WMOCSVBuffer, *FPaths::Combine(WMOCSVPath, WMOCSV)))
+	{
+		PlacementCsvReader Reader(reinterpret_cast<const char *>(WMOCSVBuffer.GetData()), WMOCSVBuffer.Num());
+		PlacementCsvRow Row;
+		while (Reader.ReadRow(Row))
+		{
+			double Values[PlacementValueCount];
+			if (!ReadPlacementValues(Row, Values))
+				continue; // Truncated row
+
+			WMOChildPlacement Child;
+			const FUTF8ToTCHAR RelativePath(Row.Fields[0].data(), (int32)Row.Fields[0].size());
+			Child.ModelIndex = InternModelPath(FPaths::ConvertRelativePathToFull(WMOCSVPath, FString(RelativePath.Length(), RelativePath.Get())));
+			if (Child.ModelIndex == INDEX_NONE)
+				continue; // Skip empty or invalid obj files
+
+			const PlacementTransform Transform = ConvertWMOChildPlacement(Values);
+
+			Child.Position = FVector(Transform.Position[0], Transform.Position[1], Transform.Position[2]);
+			Child.Rotation = FQuat(Transform.Quat[0], Transform.Quat[1], Transform.Quat[2], Transform.Quat[3]);
+			Child.Scale = Transform.Scale;
+			ChildPlacements.Add(Child);
+		}
+	}
+	return ChildPlacements;
+}
+
+bool ActorDedupIndex::Contains(const TArray<ActorData> &Actors, const ActorData &Actor) const
+{
+	const FIntVector Cell = GetCell(Actor.Position);
+	TArray<int32, TInlineAllocator<8>> Candidates;
+	for (int Z = -1; Z <= 1; Z++)
+		for (int Y = -1; Y <= 1; Y++)
+			for (int X = -1; X <= 1; X++)
+			{
+				Candidates.Reset();
+				Cells.MultiFind(GetKey(Actor.ModelIndex, Cell + FIntVector(X, Y, Z)), Candidates);
+				for (int32 Index : Candidates)
+					if (Actors[Index] == Actor)
+						return true;
+			}
+	return false;
+}
+
+void ActorDedupIndex::Add(TArray<ActorData> &Actors, const ActorData &Actor)
+{
+	Cells.Add(GetKey(Actor.ModelIndex, GetCell(Actor.Position)), Actors.Add(Actor));
+}
+
+FIntVector ActorDedupIndex::GetCell(const FVector &Position)
+{
+	return FIntVector(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize), FMath::FloorToInt32(Position.Z / CellSize));
+}
+
+uint32 ActorDedupIndex::GetKey(const int ModelIndex, const FIntVector &Cell)
+{
+	return HashCombine(GetTypeHash(ModelIndex), GetTypeHash(Cell));
+}
+
+int FWoWLandscapeImporterModule::ImportLayers(TMap<int, TTuple<FString, FString, int>> &TexturePaths, TArray<FString> &FoliageFiles, TArray<FString> &FoliageJSONs, UMaterial *ModelMaterial)
 {
 	// Find the Map Key with the highest count for each Texture Path
 	TMap<FString, int> BestKeys;
@@ -532,58 +1020,92 @@ void FWoWLandscapeImporterModule::ImportLayers(TMap<int, TTuple<FString, FString
 	ImportParams.bIsAutomated = true;
 	ImportParams.bReplaceExisting = true;
 
-	TArray<TTuple<UE::Interchange::FAssetImportResultRef, UE::Interchange::FAssetImportResultRef>> ImportResults;
+	// Creates the layer info of a layer texture and bundles it with the layer's textures
+	auto MakeLayerMetadata = [](const FString &TexturePath, UTexture2D *LayerTexture, UTexture2D *LayerTextureHeight)
+	{
+		const FString DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TexturePath).Replace(TEXT("../"), TEXT("")));
+		FString TextureFileName = FPaths::GetBaseFilename(TexturePath);
+		FString LayerInfoName = FString::Printf(TEXT("LI_%s"), *TextureFileName);
+
+		UPackage *LayerInfoPackage = CreatePackage(*(DestinationDirectory + TEXT("/") + LayerInfoName));
+		ULandscapeLayerInfoObject *LayerInfo = NewObject<ULandscapeLayerInfoObject>(LayerInfoPackage, *LayerInfoName, RF_Public | RF_Standalone);
+		LayerInfo->LayerName = FName(*TextureFileName);
+		LayerInfo->PhysMaterial = nullptr;
+		LayerInfo->LayerUsageDebugColor = FLinearColor::White;
+		LayerInfo->MarkPackageDirty();
+
+		LayerMetadata Metadata;
+		Metadata.LayerInfo = LayerInfo;
+		Metadata.LayerTexture = LayerTexture;
+		Metadata.LayerTextureHeight = LayerTextureHeight;
+		Metadata.FoliageAsset = nullptr;
+		return Metadata;
+	};
+
+	const double TextureImportStartTime = FPlatformTime::Seconds();
+	TMap<int, LayerMetadata> CompletedLayers;
+	TArray<TTuple<int, UE::Interchange::FAssetImportResultRef, UE::Interchange::FAssetImportResultRef>> PendingImports;
 	for (auto &TextureTuple : TexturePaths)
 	{
-		FString DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<0>()).Replace(TEXT("../"), TEXT("")));
-		UInterchangeSourceData *SourceData = UInterchangeManager::CreateSourceData(FPaths::ConvertRelativePathToFull(DirectoryPath, TextureTuple.Value.Get<0>().RightChop(3)));
-		UE::Interchange::FAssetImportResultRef ImportResult = InterchangeManager.ImportAssetAsync(DestinationDirectory, SourceData, ImportParams);
+		const FString DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<0>()).Replace(TEXT("../"), TEXT("")));
+		const FString SourcePath = FPaths::ConvertRelativePathToFull(DirectoryPath, TextureTuple.Value.Get<0>().RightChop(3));
+		const FString DestinationDirectoryHeight = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<1>()).Replace(TEXT("../"), TEXT("")));
+		const FString SourcePathHeight = FPaths::ConvertRelativePathToFull(DirectoryPath, TextureTuple.Value.Get<1>().RightChop(3));
 
-		DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<1>()).Replace(TEXT("../"), TEXT("")));
-		SourceData = UInterchangeManager::CreateSourceData(FPaths::ConvertRelativePathToFull(DirectoryPath, TextureTuple.Value.Get<1>().RightChop(3)));
-		UE::Interchange::FAssetImportResultRef ImportResultHeight = InterchangeManager.ImportAssetAsync(DestinationDirectory, SourceData, ImportParams);
+		if (bSkipExistingAssets)
+		{
+			UTexture2D *LayerTexture = Cast<UTexture2D>(FindUnchangedAsset(DestinationDirectory, SourcePath).GetAsset());
+			UTexture2D *LayerTextureHeight = Cast<UTexture2D>(FindUnchangedAsset(DestinationDirectoryHeight, SourcePathHeight).GetAsset());
+			if (LayerTexture && LayerTextureHeight)
+			{
+				CompletedLayers.Add(TextureTuple.Key, MakeLayerMetadata(TextureTuple.Value.Get<0>(), LayerTexture, LayerTextureHeight));
+				continue;
+			}
+		}
 
-		ImportResults.Add(MakeTuple(ImportResult, ImportResultHeight));
+		UE::Interchange::FAssetImportResultRef ImportResult = InterchangeManager.ImportAssetAsync(DestinationDirectory, UInterchangeManager::CreateSourceData(SourcePath), ImportParams);
+		UE::Interchange::FAssetImportResultRef ImportResultHeight = InterchangeManager.ImportAssetAsync(DestinationDirectoryHeight, UInterchangeManager::CreateSourceData(SourcePathHeight), ImportParams);
+		PendingImports.Add(MakeTuple(TextureTuple.Key, ImportResult, ImportResultHeight));
 	}
+	const int NumReusedLayers = CompletedLayers.Num();
+	int NumFailed = 0;
 
 	{
-		FScopedSlowTask SlowTask(ImportResults.Num(), LOCTEXT("ImportingWoWLayers", "Importing WoW Layers..."));
+		FScopedSlowTask SlowTask(PendingImports.Num(), LOCTEXT("ImportingWoWLayers", "Importing WoW Layers..."));
 		SlowTask.MakeDialog();
 
-		int Index = 0;
-		for (auto &TextureTuple : TexturePaths)
+		int NumCompleted = 0;
+		while (PendingImports.Num() > 0)
 		{
-			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("ImportingLayer", "Importing Layer: {0}"), Index));
-			const UE::Interchange::FAssetImportResultRef &ImportResult = ImportResults[Index].Get<0>();
-			const UE::Interchange::FAssetImportResultRef &ImportResultHeight = ImportResults[Index].Get<1>();
-
-			const FString DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<0>()).Replace(TEXT("../"), TEXT("")));
-			FString TextureFileName = FPaths::GetBaseFilename(TextureTuple.Value.Get<0>());
-			FString LayerInfoName = FString::Printf(TEXT("LI_%s"), *TextureFileName);
-
-			UPackage *LayerInfoPackage = CreatePackage(*(DestinationDirectory + TEXT("/") + LayerInfoName));
-			ULandscapeLayerInfoObject *LayerInfo = NewObject<ULandscapeLayerInfoObject>(LayerInfoPackage, *LayerInfoName, RF_Public | RF_Standalone);
-			LayerInfo->LayerName = FName(*TextureFileName);
-			LayerInfo->PhysMaterial = nullptr;
-			LayerInfo->LayerUsageDebugColor = FLinearColor::White;
-			LayerInfo->MarkPackageDirty();
-
-			LayerMetadata Metadata;
-			Metadata.LayerInfo = LayerInfo;
-			ImportResult->WaitUntilDone();
-			ImportResultHeight->WaitUntilDone();
-			if (ImportResult->GetImportedObjects().Num() > 0)
-				Metadata.LayerTexture = Cast<UTexture2D>(ImportResult->GetImportedObjects()[0]);
-			if (ImportResultHeight->GetImportedObjects().Num() > 0)
-				Metadata.LayerTextureHeight = Cast<UTexture2D>(ImportResultHeight->GetImportedObjects()[0]);
-			Metadata.FoliageAsset = nullptr;
-			LayerMetadataMap.Add(LayerInfo->LayerName, Metadata);
-
-			Index++;
+			// Set up each layer as soon as both of its textures are in, rather than stalling on the slowest texture in submission order
+			const int PendingIndex = WaitForAnyImport(PendingImports.Num(), [&PendingImports](int Index)
+													  { return PendingImports[Index].Get<1>()->GetStatus() == UE::Interchange::FImportResult::EStatus::Done &&
+															   PendingImports[Index].Get<2>()->GetStatus() == UE::Interchange::FImportResult::EStatus::Done; });
+			const TTuple<int, UE::Interchange::FAssetImportResultRef, UE::Interchange::FAssetImportResultRef> ImportTuple = PendingImports[PendingIndex];
+			PendingImports.RemoveAtSwap(PendingIndex);
+
+			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("ImportingLayer", "Importing Layer: {0}"), NumCompleted++));
+			const UE::Interchange::FAssetImportResultRef &ImportResult = ImportTuple.Get<1>();
+			const UE::Interchange::FAssetImportResultRef &ImportResultHeight = ImportTuple.Get<2>();
+
+			UTexture2D *LayerTexture = ImportResult->GetImportedObjects().Num() > 0 ? Cast<UTexture2D>(ImportResult->GetImportedObjects()[0]) : nullptr;
+			UTexture2D *LayerTextureHeight = ImportResultHeight->GetImportedObjects().Num() > 0 ? Cast<UTexture2D>(ImportResultHeight->GetImportedObjects()[0]) : nullptr;
+			if (!LayerTexture || !LayerTextureHeight)
+			{
+				UE_LOG(LogWoWLandscapeImporter, Error, TEXT("Failed to import the textures of layer %s"), *TexturePaths[ImportTuple.Get<0>()].Get<0>());
+				NumFailed++;
+			}
+			CompletedLayers.Add(ImportTuple.Get<0>(), MakeLayerMetadata(TexturePaths[ImportTuple.Get<0>()].Get<0>(), LayerTexture, LayerTextureHeight));
 		}
 	}
 
-	TArray<UStaticMesh *> ImportedFoliage = ImportModels(FoliageFiles, ModelMaterial, true);
+	// Layers finish in any order, but the landscape material is laid out in LayerMetadataMap order, so they are added in TexturePaths order
+	for (auto &TextureTuple : TexturePaths)
+		LayerMetadataMap.Add(CompletedLayers[TextureTuple.Key].LayerInfo->LayerName, CompletedLayers[TextureTuple.Key]);
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Imported %d layer textures in %.2f s, reused %d unchanged ones"), (TexturePaths.Num() - NumReusedLayers) * 2, FPlatformTime::Seconds() - TextureImportStartTime, NumReusedLayers * 2);
+
+	TMap<FString, UStaticMesh *> ImportedFoliage = ImportModels(FoliageFiles, ModelMaterial, true);
+	NumFailed += FoliageFiles.Num() - ImportedFoliage.Num();
 
 	// Map foliage mesh to corresponding layers in LayerMetadataMap
 	for (FString &FoliageJSON : FoliageJSONs)
@@ -601,14 +1123,8 @@ void FWoWLandscapeImporterModule::ImportLayers(TMap<int, TTuple<FString, FString
 		TArray<UStaticMesh *> FoliageMeshes;
 		for (const FString &FoliageName : FoliageNames)
 		{
-			for (UStaticMesh *ImportedMesh : ImportedFoliage)
-			{
-				if (ImportedMesh->GetName() == FoliageName)
-				{
-					FoliageMeshes.Add(ImportedMesh);
-					break;
-				}
-			}
+			if (UStaticMesh *ImportedMesh = ImportedFoliage.FindRef(FPaths::Combine(DirectoryPath, TEXT("foliage/"), FPaths::GetBaseFilename(FoliageName) + TEXT(".obj"))))
+				FoliageMeshes.Add(ImportedMesh);
 		}
 
 		if (FoliageMeshes.Num() > 0)
@@ -639,13 +1155,86 @@ void FWoWLandscapeImporterModule::ImportLayers(TMap<int, TTuple<FString, FString
 			LayerMetaData->FoliageAsset = FoliageAsset;
 		}
 	}
+	return NumFailed;
+}
+
+bool FWoWLandscapeImporterModule::LoadExistingLayers(const TMap<int, TTuple<FString, FString, int>> &TexturePaths)
+{
+	TMap<FName, LayerMetadata> ExistingLayers;
+	for (const TPair<int, TTuple<FString, FString, int>> &TextureTuple : TexturePaths)
+	{
+		// Same asset paths as ImportLayers, a texture path referenced by several effect IDs is one layer
+		const FString DestinationDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<0>()).Replace(TEXT("../"), TEXT("")));
+		const FString TextureFileName = FPaths::GetBaseFilename(TextureTuple.Value.Get<0>());
+		if (ExistingLayers.Contains(FName(*TextureFileName)))
+			continue;
+		const FString HeightDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/%s"), *FPaths::GetPath(TextureTuple.Value.Get<1>()).Replace(TEXT("../"), TEXT("")));
+		const FString HeightFileName = FPaths::GetBaseFilename(TextureTuple.Value.Get<1>());
+
+		LayerMetadata Metadata;
+		Metadata.LayerInfo = LoadObject<ULandscapeLayerInfoObject>(nullptr, *FString::Printf(TEXT("%s/LI_%s.LI_%s"), *DestinationDirectory, *TextureFileName, *TextureFileName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		Metadata.LayerTexture = LoadObject<UTexture2D>(nullptr, *FString::Printf(TEXT("%s/%s.%s"), *DestinationDirectory, *TextureFileName, *TextureFileName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		Metadata.LayerTextureHeight = LoadObject<UTexture2D>(nullptr, *FString::Printf(TEXT("%s/%s.%s"), *HeightDirectory, *HeightFileName, *HeightFileName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		// Layers without foliage have no grass type
+		Metadata.FoliageAsset = LoadObject<ULandscapeGrassType>(nullptr, *FString::Printf(TEXT("%s/GT_%s.GT_%s"), *DestinationDirectory, *TextureFileName, *TextureFileName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+		if (!Metadata.LayerInfo || !Metadata.LayerTexture || !Metadata.LayerTextureHeight)
+		{
+			UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Layer %s has no assets from a previous import, importing all layers"), *TextureFileName);
+			return false;
+		}
+		ExistingLayers.Add(Metadata.LayerInfo->LayerName, Metadata);
+	}
+
+	LayerMetadataMap = MoveTemp(ExistingLayers);
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Reusing %d existing layers"), LayerMetadataMap.Num());
+	return true;
 }
 
-TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString> &ModelPaths, UMaterial *ModelMaterial, bool isFoliage)
+TArray<FString> FWoWLandscapeImporterModule::GetModelSidecarPaths(const FString &ModelPath)
+{
+	return {ModelPath.Replace(TEXT(".obj"), TEXT(".json")), ModelPath.Replace(TEXT(".obj"), TEXT(".mtl")), FPaths::GetPath(ModelPath) / FPaths::GetCleanFilename(ModelPath.Replace(TEXT(".obj"), TEXT(".phys.obj")))};
+}
+
+void FWoWLandscapeImporterModule::RecordModelSidecars(UAssetImportData *AssetImportData, const FString &ModelPath)
+{
+	// Fixed indices, so import data kept through a reimport is overwritten rather than growing by the sidecars every time
+	const TArray<FString> SidecarPaths = GetModelSidecarPaths(ModelPath);
+	for (int i = 0; i < SidecarPaths.Num(); i++)
+		AssetImportData->AddFileName(SidecarPaths[i], 1 + i);
+}
+
+TMap<FString, UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString> &ModelPaths, UMaterial *ModelMaterial, bool isFoliage)
 {
 	// Remove duplicates from the asset paths
 	ModelPaths = TSet<FString>(MoveTemp(ModelPaths)).Array();
 
+	// Meshes are keyed by the full path of their source model
+	TMap<FString, UStaticMesh *> ImportedModels;
+	ImportedModels.Reserve(ModelPaths.Num());
+
+	// Meshes imported before from an unchanged model are reused as they are, with the materials and collision set up back then. Hashing the sources is spread across the worker threads.
+	TArray<FAssetData> ExistingModels;
+	ExistingModels.SetNum(ModelPaths.Num());
+	if (bSkipExistingAssets)
+		ParallelFor(ModelPaths.Num(), [this, &ModelPaths, &ExistingModels](int32 i)
+					{ ExistingModels[i] = FindUnchangedAsset(TEXT("/Game/Assets/WoWExport/Meshes"), ModelPaths[i], GetModelSidecarPaths(ModelPaths[i])); });
+
+	TArray<int> ModelsToImport;
+	for (int i = 0; i < ModelPaths.Num(); i++)
+	{
+		if (UStaticMesh *ExistingMesh = Cast<UStaticMesh>(ExistingModels[i].GetAsset()))
+			ImportedModels.Add(ModelPaths[i], ExistingMesh);
+		else
+			ModelsToImport.Add(i);
+	}
+
+	// The model JSONs do not touch any UObject, so they are parsed on worker threads while Interchange imports the meshes
+	TArray<JsonData> ModelJsons;
+	ModelJsons.SetNum(ModelPaths.Num());
+	TFuture<void> ModelJsonsParsed = Async(EAsyncExecution::ThreadPool, [this, &ModelPaths, &ModelsToImport, &ModelJsons]()
+										   { ParallelFor(ModelsToImport.Num(), [this, &ModelPaths, &ModelsToImport, &ModelJsons](int32 i)
+														 { ModelJsons[ModelsToImport[i]] = ParseModelJson(ModelPaths[ModelsToImport[i]].Replace(TEXT(".obj"), TEXT(".json"))); }); });
+
 	UInterchangeGenericAssetsPipeline *Pipeline = NewObject<UInterchangeGenericAssetsPipeline>();
 	Pipeline->bUseSourceNameForAsset = true;
 	Pipeline->ReimportStrategy = EReimportStrategyFlags::ApplyNoProperties;
@@ -661,42 +1250,77 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 	ImportParams.bReplaceExisting = true;
 	ImportParams.OverridePipelines.Add(FSoftObjectPath(Pipeline));
 
-	UInterchangeManager &InterchangeManager = UInterchangeManager::GetInterchangeManager();
-	TArray<TTuple<FString, UE::Interchange::FAssetImportResultRef, UE::Interchange::FAssetImportResultRef>> ImportResults;
-	for (const FString &ModelPath : ModelPaths)
+	// Most doodads ship without a collision mesh, so find the .phys.obj files that actually exist once per directory instead of submitting an import for every model. Reused models are not imported, so their directories are not scanned
+	TSet<FString> ScannedDirectories;
+	TSet<FString> CollisionFiles;
+	for (const int ModelIndex : ModelsToImport)
 	{
-		// Import the source model
-		UInterchangeSourceData *SourceData = UInterchangeManager::CreateSourceData(ModelPath);
-		UE::Interchange::FAssetImportResultRef ImportResult = InterchangeManager.ImportAssetAsync(TEXT("/Game/Assets/WoWExport/Meshes/"), SourceData, ImportParams);
-
-		// Import the corresponding collision model(if it exists)
-		UInterchangeSourceData *SourceDataCollision = UInterchangeManager::CreateSourceData(ModelPath.Replace(TEXT(".obj"), TEXT(".phys.obj")));
-		UE::Interchange::FAssetImportResultRef ImportResultCollision = InterchangeManager.ImportAssetAsync(TEXT("/Game/Assets/WoWExport/Meshes/"), SourceDataCollision, ImportParams);
+		const FString Directory = FPaths::GetPath(ModelPaths[ModelIndex]);
+		if (ScannedDirectories.Contains(Directory))
+			continue;
+		ScannedDirectories.Add(Directory);
 
-		ImportResults.Add(MakeTuple(ModelPath, ImportResult, ImportResultCollision));
+		TArray<FString> FoundFiles;
+		IFileManager::Get().FindFiles(FoundFiles, *(Directory / TEXT("*.phys.obj")), true, false);
+		for (const FString &FoundFile : FoundFiles)
+			CollisionFiles.Add(Directory / FoundFile);
 	}
+	int NumSkippedCollisionImports = 0;
+
+	const double ModelImportStartTime = FPlatformTime::Seconds();
+	UInterchangeManager &InterchangeManager = UInterchangeManager::GetInterchangeManager();
 
-	TArray<UStaticMesh *> ImportedModels;
 	TMap<FString, MtlData> NewMtls;
+	TMap<FString, MtlData> SignatureToMtl;
 	TMap<FString, UTexture2D *> ImportedTextures;
 	{
-		FScopedSlowTask SlowTask(ImportResults.Num(), LOCTEXT("ImportingModels", "Importing Models..."));
+		FScopedSlowTask SlowTask(ModelsToImport.Num(), LOCTEXT("ImportingModels", "Importing Models..."));
 		SlowTask.MakeDialog();
 
-		int ModelIndex = 0;
-		for (const TTuple<FString, UE::Interchange::FAssetImportResultRef, UE::Interchange::FAssetImportResultRef> &ImportTuple : ImportResults)
+		int NextModel = 0;
+		int NumCompleted = 0;
+		TArray<TTuple<int, UE::Interchange::FAssetImportResultRef, TSharedPtr<UE::Interchange::FImportResult, ESPMode::ThreadSafe>>> PendingImports;
+		while (NextModel < ModelsToImport.Num() || PendingImports.Num() > 0)
 		{
-			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("ImportingModel", "Importing Model: {0}"), ModelIndex++));
-			const FString &ModelPath = ImportTuple.Get<0>();
+			// Keep at most MaxConcurrentImports models in flight instead of queueing the whole map on Interchange at once
+			while (NextModel < ModelsToImport.Num() && PendingImports.Num() < MaxConcurrentImports)
+			{
+				const FString &ModelPath = ModelPaths[ModelsToImport[NextModel]];
+
+				// Import the source model
+				UInterchangeSourceData *SourceData = UInterchangeManager::CreateSourceData(ModelPath);
+				UE::Interchange::FAssetImportResultRef ImportResult = InterchangeManager.ImportAssetAsync(TEXT("/Game/Assets/WoWExport/Meshes/"), SourceData, ImportParams);
+
+				// Import the corresponding collision model(if it exists)
+				TSharedPtr<UE::Interchange::FImportResult, ESPMode::ThreadSafe> ImportResultCollision;
+				const FString CollisionPath = FPaths::GetPath(ModelPath) / FPaths::GetCleanFilename(ModelPath.Replace(TEXT(".obj"), TEXT(".phys.obj")));
+				if (CollisionFiles.Contains(CollisionPath))
+				{
+					UInterchangeSourceData *SourceDataCollision = UInterchangeManager::CreateSourceData(CollisionPath);
+					ImportResultCollision = InterchangeManager.ImportAssetAsync(TEXT("/Game/Assets/WoWExport/Meshes/"), SourceDataCollision, ImportParams);
+				}
+				else
+					NumSkippedCollisionImports++;
+
+				PendingImports.Add(MakeTuple(ModelsToImport[NextModel++], ImportResult, ImportResultCollision));
+			}
+
+			// A model is done once both its render and collision imports are, and it is post-processed straight away so its slot in the window can be refilled
+			const int PendingIndex = WaitForAnyImport(PendingImports.Num(), [&PendingImports](int Index)
+													  { return PendingImports[Index].Get<1>()->GetStatus() == UE::Interchange::FImportResult::EStatus::Done &&
+															   (!PendingImports[Index].Get<2>().IsValid() || PendingImports[Index].Get<2>()->GetStatus() == UE::Interchange::FImportResult::EStatus::Done); });
+			const TTuple<int, UE::Interchange::FAssetImportResultRef, TSharedPtr<UE::Interchange::FImportResult, ESPMode::ThreadSafe>> ImportTuple = PendingImports[PendingIndex];
+			PendingImports.RemoveAtSwap(PendingIndex);
+
+			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("ImportingModel", "Importing Model: {0}"), NumCompleted++));
+			const int ModelIndex = ImportTuple.Get<0>();
 			const UE::Interchange::FAssetImportResultRef &ImportResult = ImportTuple.Get<1>();
-			const UE::Interchange::FAssetImportResultRef &ImportResultPhys = ImportTuple.Get<2>();
+			const TSharedPtr<UE::Interchange::FImportResult, ESPMode::ThreadSafe> &ImportResultPhys = ImportTuple.Get<2>();
 
-			// Extract data from corresponding json file
-			const FString JsonPath = ModelPath.Replace(TEXT(".obj"), TEXT(".json"));
-			const TSharedPtr<FJsonObject> JsonObject = LoadJsonObject(JsonPath);
-			const JsonData Json = ParseModelJson(JsonObject);
+			// Data extracted from the corresponding json file
+			ModelJsonsParsed.Wait();
+			const JsonData &Json = ModelJsons[ModelIndex];
 
-			ImportResult->WaitUntilDone();
 			const TArray<UObject *> &ImportedObjects = ImportResult->GetImportedObjects();
 
 			for (UObject *ImportedObject : ImportedObjects)
@@ -708,8 +1332,7 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 					Mesh->SetLODGroup(FName("LevelArchitecture"), false);
 					Mesh->GetBodySetup()->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseComplexAsSimple;
 
-					ImportResultPhys->WaitUntilDone();
-					if (ImportResultPhys->GetImportedObjects().Num() > 0)
+					if (ImportResultPhys.IsValid() && ImportResultPhys->GetImportedObjects().Num() > 0)
 						Mesh->ComplexCollisionMesh = Cast<UStaticMesh>(ImportResultPhys->GetImportedObjects()[0]);
 
 					bool isInjected = false;
@@ -719,26 +1342,20 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 					{
 						FStaticMaterial &StaticMtl = Mesh->GetStaticMaterials()[i];
 						FString MtlName = StaticMtl.MaterialSlotName.ToString();
-						TSharedPtr<FJsonObject> MtlObject = Json.MtlNameToMtlObject[MtlName];
+						const MaterialJson &MtlObject = Json.Model.Materials[Json.MtlNameToMaterial[MtlName]];
 
 						// If the material instance already exists, then we skip this
 						if (!NewMtls.Contains(MtlName))
 						{
-							IAssetTools &AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
-							UObject *NewAsset = AssetTools.CreateAsset(MtlName, TEXT("/Game/Assets/WoWExport/Meshes/Materials/"), UMaterialInstanceConstant::StaticClass(), NewObject<UMaterialInstanceConstantFactoryNew>());
 							MtlData Mtl;
-							Mtl.Instance = Cast<UMaterialInstanceConstant>(NewAsset);
-							Mtl.Instance->SetParentEditorOnly(ModelMaterial);
 
-							if (Json.FileType == TEXT("wmo"))
+							if (Json.Model.FileType == TEXT("wmo"))
 							{
-								const int Shader = MtlObject->GetIntegerField(TEXT("shader"));
-								int BlendMode = MtlObject->GetIntegerField(TEXT("blendMode"));
+								const int Shader = MtlObject.Shader;
+								int BlendMode = MtlObject.BlendMode;
 								bool isEmissive = Shader == 9 || Shader == 12 || Shader == 15;
-								Mtl.Instance->BasePropertyOverrides.bOverride_BlendMode = true;
-								Mtl.Instance->BasePropertyOverrides.BlendMode = EGxBlendToUE5(BlendMode);
-								Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("IsEmissive"), isEmissive);
-								Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("IsReflective"), true);
+								Mtl.StaticSwitches.Add(FName("IsEmissive"), isEmissive);
+								Mtl.StaticSwitches.Add(FName("IsReflective"), true);
 
 								Mtl.BlendMode = BlendMode;
 								Mtl.isM2 = false;
@@ -747,47 +1364,44 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 								{
 									if (!isInjected)
 									{
-										InjectVertexColors(Mesh, JsonObject);
+										InjectVertexColors(Mesh, Json.Model);
 										isInjected = true;
 									}
 
-									Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("isMultiLayer"), true);
+									Mtl.StaticSwitches.Add(FName("isMultiLayer"), true);
 									if (Shader == 23) // MapObjUnkShader
 									{
-										if (Json.FDIDToTexName.Contains(MtlObject->GetIntegerField(TEXT("texture2"))))
-											Mtl.ParamToTexName.Add(TEXT("Texture2"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("texture2"))]);
-										if (Json.FDIDToTexName.Contains(MtlObject->GetIntegerField(TEXT("texture3"))))
-											Mtl.ParamToTexName.Add(TEXT("Texture3"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("texture3"))]);
-										if (Json.FDIDToTexName.Contains(MtlObject->GetIntegerField(TEXT("color3"))))
-											Mtl.ParamToTexName.Add(TEXT("Color3"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("color3"))]);
-										if (Json.FDIDToTexName.Contains(MtlObject->GetIntegerField(TEXT("flags3"))))
-											Mtl.ParamToTexName.Add(TEXT("Flags3"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("flags3"))]);
-
-										TArray<int> HeightFDIDs;
-										const TArray<TSharedPtr<FJsonValue>> &RuntimeDataArray = MtlObject->GetArrayField(TEXT("runtimeData"));
-										for (const TSharedPtr<FJsonValue> &Val : RuntimeDataArray)
-											HeightFDIDs.Add((int)Val->AsNumber());
+										if (const FString *TexName = Json.FDIDToTexName.Find(MtlObject.Texture2))
+											Mtl.ParamToTexName.Add(TEXT("Texture2"), *TexName);
+										if (const FString *TexName = Json.FDIDToTexName.Find(MtlObject.Texture3))
+											Mtl.ParamToTexName.Add(TEXT("Texture3"), *TexName);
+										if (const FString *TexName = Json.FDIDToTexName.Find(MtlObject.Color3))
+											Mtl.ParamToTexName.Add(TEXT("Color3"), *TexName);
+										if (const FString *TexName = Json.FDIDToTexName.Find(MtlObject.Flags3))
+											Mtl.ParamToTexName.Add(TEXT("Flags3"), *TexName);
+
+										const TArray<int> &HeightFDIDs = MtlObject.RuntimeData;
 
 										for (int j = 0; j < 4; j++)
-											if (Json.FDIDToTexName.Contains(HeightFDIDs[j]))
-												Mtl.ParamToTexName.Add(FName(*FString::Printf(TEXT("Height%d"), j)), Json.FDIDToTexName[HeightFDIDs[j]]);
+											if (const FString *TexName = Json.FDIDToTexName.Find(HeightFDIDs[j]))
+												Mtl.ParamToTexName.Add(FName(*FString::Printf(TEXT("Height%d"), j)), *TexName);
 									}
 									else // TwoLayer Shading
 									{
-										Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("isTwoLayer"), true);
-										Mtl.ParamToTexName.Add(TEXT("Texture1"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("texture1"))]);
-										Mtl.ParamToTexName.Add(TEXT("Texture2"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("texture2"))]);
+										Mtl.StaticSwitches.Add(FName("isTwoLayer"), true);
+										Mtl.ParamToTexName.Add(TEXT("Texture1"), Json.FDIDToTexName[MtlObject.Texture1]);
+										Mtl.ParamToTexName.Add(TEXT("Texture2"), Json.FDIDToTexName[MtlObject.Texture2]);
 									}
 								}
 								else
-									Mtl.ParamToTexName.Add(TEXT("Texture1"), Json.FDIDToTexName[MtlObject->GetIntegerField(TEXT("texture1"))]);
+									Mtl.ParamToTexName.Add(TEXT("Texture1"), Json.FDIDToTexName[MtlObject.Texture1]);
 							}
 							else
 							{
-								TSharedPtr<FJsonObject> TexUnit = Json.MtlNameToTexUnit[MtlName];
-								int BlendMode = M2ToEGxBlend(MtlObject->GetIntegerField(TEXT("blendingMode")));
-								int MtlFlags = MtlObject->GetIntegerField(TEXT("flags"));
-								int TexFlags = TexUnit->GetIntegerField(TEXT("flags"));
+								const TextureUnitJson &TexUnit = Json.Model.TextureUnits[Json.MtlNameToTexUnit[MtlName]];
+								int BlendMode = M2ToEGxBlend(MtlObject.BlendingMode);
+								int MtlFlags = MtlObject.Flags;
+								int TexFlags = TexUnit.Flags;
 								bool isEmissive = (MtlFlags & 0x01) != 0;
 								bool isTwoSided = (MtlFlags & 0x04) != 0;
 								bool isReflective = (TexFlags & 0x80) != 0;
@@ -796,29 +1410,59 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 								Mtl.BlendMode = BlendMode;
 								Mtl.isM2 = true;
 
-								Mtl.Instance->BasePropertyOverrides.bOverride_BlendMode = true;
-								Mtl.Instance->BasePropertyOverrides.BlendMode = EGxBlendToUE5(BlendMode);
-								Mtl.Instance->BasePropertyOverrides.bOverride_TwoSided = true;
-								Mtl.Instance->BasePropertyOverrides.TwoSided = isTwoSided || isEmissive;
-								Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("IsEmissive"), isEmissive);
-								Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("IsReflective"), isReflective);
+								Mtl.TwoSided = isTwoSided || isEmissive;
+								Mtl.StaticSwitches.Add(FName("IsEmissive"), isEmissive);
+								Mtl.StaticSwitches.Add(FName("IsReflective"), isReflective);
 
 								if (isReflective)
-									Mtl.Instance->SetScalarParameterValueEditorOnly(FName("Metallic"), 1.0f);
+									Mtl.ScalarParams.Add(FName("Metallic"), 1.0f);
 
 								if (isTwoSided && BlendMode == 1 && isFoliage)
+								{
+									Mtl.isTwoSidedFoliage = true;
+									Mtl.StaticSwitches.Add(FName("EnableWind"), true);
+								}
+							}
+
+							// Material names that resolve to the same settings share one instance instead of each getting a duplicate of it
+							const FString Signature = Mtl.GetSignature();
+							if (const MtlData *SharedMtl = SignatureToMtl.Find(Signature))
+								Mtl.Instance = SharedMtl->Instance;
+							else
+							{
+								IAssetTools &AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
+								UObject *NewAsset = AssetTools.CreateAsset(MtlName, TEXT("/Game/Assets/WoWExport/Meshes/Materials/"), UMaterialInstanceConstant::StaticClass(), NewObject<UMaterialInstanceConstantFactoryNew>());
+								Mtl.Instance = Cast<UMaterialInstanceConstant>(NewAsset);
+								Mtl.Instance->SetParentEditorOnly(ModelMaterial);
+								Mtl.Instance->BasePropertyOverrides.bOverride_BlendMode = true;
+								Mtl.Instance->BasePropertyOverrides.BlendMode = EGxBlendToUE5(Mtl.BlendMode);
+								if (Mtl.TwoSided.IsSet())
+								{
+									Mtl.Instance->BasePropertyOverrides.bOverride_TwoSided = true;
+									Mtl.Instance->BasePropertyOverrides.TwoSided = Mtl.TwoSided.GetValue();
+								}
+								if (Mtl.isTwoSidedFoliage)
 								{
 									Mtl.Instance->BasePropertyOverrides.bOverride_ShadingModel = true;
 									Mtl.Instance->BasePropertyOverrides.ShadingModel = EMaterialShadingModel::MSM_TwoSidedFoliage;
-									Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("EnableWind"), true);
 								}
+								for (const TPair<FName, bool> &Switch : Mtl.StaticSwitches)
+									Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(Switch.Key, Switch.Value);
+								for (const TPair<FName, float> &Scalar : Mtl.ScalarParams)
+									Mtl.Instance->SetScalarParameterValueEditorOnly(Scalar.Key, Scalar.Value);
+
+								SignatureToMtl.Add(Signature, Mtl);
 							}
 							NewMtls.Add(MtlName, Mtl);
 						}
 						StaticMtl.MaterialInterface = NewMtls[MtlName].Instance;
 					}
+					// The sidecars shape the mesh as much as the .obj does, so their hashes are recorded after it for FindUnchangedAsset
+					if (UAssetImportData *AssetImportData = Mesh->GetAssetImportData())
+						RecordModelSidecars(AssetImportData, ModelPaths[ModelIndex]);
+
 					Mesh->PostEditChange();
-					ImportedModels.Add(Mesh);
+					ImportedModels.Add(ModelPaths[ModelIndex], Mesh);
 				}
 
 				if (UTexture2D *Texture = Cast<UTexture2D>(ImportedObject))
@@ -827,13 +1471,17 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 		}
 	}
 
+	ModelJsonsParsed.Wait(); // Still references ModelJsons when there was nothing to import
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Imported %d models in %.2f s, reused %d unchanged ones"), ModelsToImport.Num(), FPlatformTime::Seconds() - ModelImportStartTime, ModelPaths.Num() - ModelsToImport.Num());
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Skipped %d collision imports for models without a .phys.obj file"), NumSkippedCollisionImports);
+
 	{ // We assign textures to material instances when all textures have been imported
-		FScopedSlowTask SlowTask(NewMtls.Num(), LOCTEXT("AssigningTextures", "Assigning Textures..."));
+		FScopedSlowTask SlowTask(SignatureToMtl.Num(), LOCTEXT("AssigningTextures", "Assigning Textures..."));
 		SlowTask.MakeDialog();
 
-		for (auto &MtlPair : NewMtls)
+		for (auto &MtlPair : SignatureToMtl)
 		{
-			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("AssigningTexture", "Assigning Textures for Material: {0}"), FText::FromString(MtlPair.Key)));
+			SlowTask.EnterProgressFrame(1.0f, FText::Format(LOCTEXT("AssigningTexture", "Assigning Textures for Material: {0}"), FText::FromString(MtlPair.Value.Instance->GetName())));
 			MtlData &Mtl = MtlPair.Value;
 			for (auto &ParamPair : Mtl.ParamToTexName)
 			{
@@ -843,127 +1491,182 @@ TArray<UStaticMesh *> FWoWLandscapeImporterModule::ImportModels(TArray<FString>
 				if (Texture->HasAlphaChannel() && (Mtl.BlendMode != 1 && Mtl.BlendMode != 2 && Mtl.BlendMode != 11))
 				{
 					Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("isReflective"), true);
+					Mtl.StaticSwitches.Add(FName("isReflective"), true);
 					Mtl.Instance->SetScalarParameterValueEditorOnly(FName("Metallic"), 1.0f);
 					if (Mtl.isM2)
+					{
 						Mtl.Instance->SetStaticSwitchParameterValueEditorOnly(FName("InvertAlpha"), true);
+						Mtl.StaticSwitches.Add(FName("InvertAlpha"), true);
+					}
 				}
 				Mtl.Instance->PostEditChange();
 			}
 		}
 	}
+
+	// Sharing only removes duplicate instances, the shaders compiled depend on how many distinct static switch sets remain
+	TSet<FString> StaticSwitchSets;
+	for (const TPair<FString, MtlData> &MtlPair : SignatureToMtl)
+		StaticSwitchSets.Add(MtlPair.Value.GetPermutationSignature());
+	UE_LOG(LogWoWLandscapeImporter, Log, TEXT("Created %d material instances for %d material names (%d duplicate instances avoided), with %d distinct static switch sets"), SignatureToMtl.Num(), NewMtls.Num(), NewMtls.Num() - SignatureToMtl.Num(), StaticSwitchSets.Num());
 	return ImportedModels;
 }
 
-JsonData FWoWLandscapeImporterModule::ParseModelJson(const TSharedPtr<FJsonObject> &JsonObject)
+FString MtlData::GetPermutationSignature() const
 {
-	JsonData Json;
-	Json.FileType = JsonObject->GetStringField(TEXT("fileType"));
-	TArray<TSharedPtr<FJsonValue>> MtlArray = JsonObject->GetArrayField(TEXT("materials"));
-	TArray<TSharedPtr<FJsonValue>> TexArray = JsonObject->GetArrayField(TEXT("textures"));
-	TArray<TSharedPtr<FJsonValue>> TexComboArray = JsonObject->GetArrayField(TEXT("textureCombos"));
+	FString Signature = FString::Printf(TEXT("%d|%d|%d|%d"), BlendMode, isM2, TwoSided.IsSet() ? (int)TwoSided.GetValue() : -1, isTwoSidedFoliage);
+
+	TArray<FName> Names;
+	StaticSwitches.GetKeys(Names);
+	Names.Sort(FNameLexicalLess());
+	for (const FName &Name : Names)
+		Signature += FString::Printf(TEXT("|%s=%d"), *Name.ToString(), StaticSwitches[Name]);
+	return Signature;
+}
+
+FString MtlData::GetSignature() const
+{
+	FString Signature = GetPermutationSignature();
+
+	TArray<FName> Names;
+	ScalarParams.GetKeys(Names);
+	Names.Sort(FNameLexicalLess());
+	for (const FName &Name : Names)
+		Signature += FString::Printf(TEXT("|%s=%f"), *Name.ToString(), ScalarParams[Name]);
+
+	// Texture parameters can only be bound after all textures are imported, so the texture names stand in for them
+	Names.Reset();
+	ParamToTexName.GetKeys(Names);
+	Names.Sort(FNameLexicalLess());
+	for (const FName &Name : Names)
+		Signature += FString::Printf(TEXT("|%s=%s"), *Name.ToString(), *ParamToTexName[Name]);
+	return Signature;
+}
+
+FAssetData FWoWLandscapeImporterModule::FindUnchangedAsset(const FString &DestinationDirectory, const FString &SourcePath, TConstArrayView<FString> SidecarPaths) const
+{
+	// Interchange names the asset after the sanitized source file name, and keeps the MD5 of the source in its import data, which the asset registry exposes as a tag
+	FString AssetName = FPaths::GetBaseFilename(SourcePath);
+	UE::Interchange::SanitizeName(AssetName);
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(FSoftObjectPath(DestinationDirectory / AssetName + TEXT(".") + AssetName));
+	FString ImportInfoJson;
+	if (!AssetData.IsValid() || !AssetData.GetTagValue(UObject::SourceFileTagName(), ImportInfoJson))
+		return FAssetData();
+
+	const TOptional<FAssetImportInfo> ImportInfo = FAssetImportInfo::FromJson(ImportInfoJson);
+	if (!ImportInfo.IsSet() || ImportInfo->SourceFiles.Num() != 1 + SidecarPaths.Num() || !ImportInfo->SourceFiles[0].FileHash.IsValid())
+		return FAssetData();
+	if (ImportInfo->SourceFiles[0].FileHash != FMD5Hash::HashFile(*SourcePath))
+		return FAssetData();
+
+	// A missing sidecar is recorded with an invalid hash, so one that appears since is a change as well
+	for (int i = 0; i < SidecarPaths.Num(); i++)
+		if (ImportInfo->SourceFiles[1 + i].FileHash != FMD5Hash::HashFile(*SidecarPaths[i]))
+			return FAssetData();
+	return AssetData;
+}
+
+int FWoWLandscapeImporterModule::WaitForAnyImport(const int NumPending, TFunctionRef<bool(int)> IsImportDone)
+{
+	while (true)
+	{
+		for (int Index = 0; Index < NumPending; Index++)
+			if (IsImportDone(Index))
+				return Index;
+
+		// Interchange finishes its imports through game thread tasks, so they have to be pumped while we wait on them
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.001f);
+	}
+}
 
-	// Build FDID -> Texture Name Lookup
-	for (int TexIdx = 0; TexIdx < TexArray.Num(); ++TexIdx)
+JsonData FWoWLandscapeImporterModule::ParseModelJson(const FString &JsonPath)
+{
+	JsonData Json;
+	if (!FWoWJsonReader::ReadModel(JsonPath, Json.Model))
+		UE_LOG(LogWoWLandscapeImporter, Warning, TEXT("Failed to read model JSON %s"), *JsonPath);
+	const ModelJson &Model = Json.Model;
+
+	// Build FDID -> Texture lookups in one pass, the first texture entry of an FDID wins
+	Json.FDIDToTexture.Reserve(Model.Textures.Num());
+	Json.FDIDToTexName.Reserve(Model.Textures.Num());
+	for (int TexIdx = 0; TexIdx < Model.Textures.Num(); ++TexIdx)
 	{
-		TSharedPtr<FJsonObject> TexObject = TexArray[TexIdx]->AsObject();
-		FString TexName = TEXT("TEX") + TexObject->GetStringField(TEXT("mtlName")).Mid(3);
-		int FDID = TexObject->GetIntegerField(TEXT("fileDataID"));
-		Json.FDIDToTexName.Add(FDID, TexName);
+		const TextureJson &Texture = Model.Textures[TexIdx];
+		if (!Json.FDIDToTexture.Contains(Texture.FileDataID))
+		{
+			Json.FDIDToTexture.Add(Texture.FileDataID, TexIdx);
+			Json.FDIDToTexName.Add(Texture.FileDataID, TEXT("TEX") + Texture.MtlName.Mid(3));
+		}
 	}
 
 	// Build Mtl Name -> Mtl Object Lookup (and Mtl Name -> Tex Unit Object for M2)
-	if (Json.FileType == TEXT("m2"))
+	if (Model.FileType == TEXT("m2"))
 	{
-		TArray<TSharedPtr<FJsonValue>> TexUnitArray = JsonObject->GetObjectField(TEXT("skin"))->GetArrayField(TEXT("textureUnits"));
-		for (int UnitIdx = 0; UnitIdx < TexUnitArray.Num(); ++UnitIdx)
+		for (int UnitIdx = 0; UnitIdx < Model.TextureUnits.Num(); ++UnitIdx)
 		{
-			TSharedPtr<FJsonObject> UnitObject = TexUnitArray[UnitIdx]->AsObject();
-			int MtlIndex = UnitObject->GetNumberField(TEXT("materialIndex"));
-			int Flags = UnitObject->GetNumberField(TEXT("flags"));
-			int TextureIndex = TexComboArray[UnitObject->GetNumberField(TEXT("textureComboIndex"))]->AsNumber();
-			FString MtlName = TexArray[TextureIndex]->AsObject()->GetStringField(TEXT("mtlName"));
+			const TextureUnitJson &Unit = Model.TextureUnits[UnitIdx];
+			if (!Model.TextureCombos.IsValidIndex(Unit.TextureComboIndex) || !Model.Textures.IsValidIndex(Model.TextureCombos[Unit.TextureComboIndex]))
+				continue;
+			const FString &MtlName = Model.Textures[Model.TextureCombos[Unit.TextureComboIndex]].MtlName;
 
-			if (!Json.MtlNameToMtlObject.Contains(MtlName) || (Flags & 0x80) != 0) // First come, first served with exception of 0x80 flag
+			if (!Json.MtlNameToMaterial.Contains(MtlName) || (Unit.Flags & 0x80) != 0) // First come, first served with exception of 0x80 flag
 			{
-				Json.MtlNameToMtlObject.Add(MtlName, MtlArray[MtlIndex]->AsObject());
-				Json.MtlNameToTexUnit.Add(MtlName, UnitObject);
+				Json.MtlNameToMaterial.Add(MtlName, Unit.MaterialIndex);
+				Json.MtlNameToTexUnit.Add(MtlName, UnitIdx);
 			}
 		}
 	}
 	else
 	{
-		for (int MtlIndex = 0; MtlIndex < MtlArray.Num(); ++MtlIndex)
+		for (int MtlIndex = 0; MtlIndex < Model.Materials.Num(); ++MtlIndex)
 		{
-			TSharedPtr<FJsonObject> MtlObject = MtlArray[MtlIndex]->AsObject();
-			int Shader = MtlObject->GetIntegerField(TEXT("shader"));
+			const MaterialJson &MtlObject = Model.Materials[MtlIndex];
+			const int Shader = MtlObject.Shader;
 
 			// shader 23 (pixelShader 20) uses texture2 as the MTL material reference in blender script
-			int FDID = 0;
-			if (Shader == 23)
-				FDID = MtlObject->GetIntegerField(TEXT("texture2"));
-			else
-				FDID = MtlObject->GetIntegerField(TEXT("texture1"));
+			const int FDID = Shader == 23 ? MtlObject.Texture2 : MtlObject.Texture1;
 
-			for (int TexIdx = 0; TexIdx < TexArray.Num(); ++TexIdx)
+			if (const int *TexIdx = Json.FDIDToTexture.Find(FDID))
 			{
-				TSharedPtr<FJsonObject> TextureObject = TexArray[TexIdx]->AsObject();
-				if (TextureObject->GetIntegerField(TEXT("fileDataID")) == FDID)
-				{
-					FString MtlName = TextureObject->GetStringField(TEXT("mtlName"));
-					if (!Json.MtlNameToMtlObject.Contains(MtlName) || Shader == 23 || Shader == 13) // First come, first served with exception of shader 23
-						Json.MtlNameToMtlObject.Add(MtlName, MtlObject);
-					break;
-				}
+				const FString &MtlName = Model.Textures[*TexIdx].MtlName;
+				if (!Json.MtlNameToMaterial.Contains(MtlName) || Shader == 23 || Shader == 13) // First come, first served with exception of shader 23
+					Json.MtlNameToMaterial.Add(MtlName, MtlIndex);
 			}
 		}
 	}
 	return Json;
 }
 
-void FWoWLandscapeImporterModule::InjectVertexColors(UStaticMesh *Mesh, const TSharedPtr<FJsonObject> &JsonObject)
+void FWoWLandscapeImporterModule::InjectVertexColors(UStaticMesh *Mesh, const ModelJson &Model)
 {
-	TArray<FVector4f> AllVertexColors;
-	const TArray<TSharedPtr<FJsonValue>> &GroupsArray = JsonObject->GetArrayField(TEXT("groups"));
-
-	for (const TSharedPtr<FJsonValue> &GroupVal : GroupsArray)
-	{
-		TSharedPtr<FJsonObject> GroupObj = GroupVal->AsObject();
+	const double StartTime = FPlatformTime::Seconds();
 
-		const TArray<TSharedPtr<FJsonValue>> *ColorArray = nullptr;
-		if (!GroupObj->TryGetArrayField(TEXT("colors2"), ColorArray))
-		{
-			const TArray<TSharedPtr<FJsonValue>> *OuterArray = nullptr;
-			if (GroupObj->TryGetArrayField(TEXT("vertexColours"), OuterArray) && OuterArray->Num() > 0)
-				ColorArray = &((*OuterArray).Last()->AsArray()); // Get the last vertex color array as this is used for TwoLayerShader
-		}
-		if (!ColorArray)
-			continue;
-
-		for (int c = 0; c < ColorArray->Num(); c += 4)
-		{
-			float B = (*ColorArray)[c]->AsNumber() / 255.0f;
-			float G = (*ColorArray)[c + 1]->AsNumber() / 255.0f;
-			float R = (*ColorArray)[c + 2]->AsNumber() / 255.0f;
-			float A = (*ColorArray)[c + 3]->AsNumber() / 255.0f;
-			AllVertexColors.Add(FVector4f(R, G, B, A));
-		}
-	}
+	// Colors are stored as BGRA bytes per vertex
+	static_assert(sizeof(FVector4f) == 4 * sizeof(float), "ConvertVertexColors writes four packed floats per color");
+	const int NumVertexColors = Model.VertexColors.Num() / 4;
+	TArray<FVector4f> AllVertexColors;
+	AllVertexColors.SetNumUninitialized(NumVertexColors);
+	ConvertVertexColors(Model.VertexColors.GetData(), NumVertexColors, reinterpret_cast<float *>(AllVertexColors.GetData()));
 
 	FMeshDescription *MeshDescription = Mesh->GetMeshDescription(0);
 	FStaticMeshAttributes Attributes(*MeshDescription);
 
 	Attributes.Register();
-	TVertexInstanceAttributesRef<FVector4f> InstanceColors = Attributes.GetVertexInstanceColors();
 	MeshDescription->VertexInstanceAttributes().RegisterAttribute<FVector4f>(MeshAttribute::VertexInstance::Color, 1, FVector4f(1.0f, 1.0f, 1.0f, 1.0f));
-	InstanceColors = Attributes.GetVertexInstanceColors();
+	TVertexInstanceAttributesRef<FVector4f> InstanceColors = Attributes.GetVertexInstanceColors();
 
+	// Write straight into the attribute storage, which is indexed by element ID
+	TArrayView<FVector4f> InstanceColorData = InstanceColors.GetRawArray();
 	for (const FVertexInstanceID VertexInstanceID : MeshDescription->VertexInstances().GetElementIDs())
 	{
-		FVertexID VertexID = MeshDescription->GetVertexInstanceVertex(VertexInstanceID);
-		if (VertexID.GetValue() < AllVertexColors.Num())
-			InstanceColors.Set(VertexInstanceID, AllVertexColors[VertexID.GetValue()]);
+		const int32 VertexIndex = MeshDescription->GetVertexInstanceVertex(VertexInstanceID).GetValue();
+		if (VertexIndex < NumVertexColors)
+			InstanceColorData[VertexInstanceID.GetValue()] = AllVertexColors[VertexIndex];
 	}
 	Mesh->CommitMeshDescription(0);
+
+	UE_LOG(LogWoWLandscapeImporter, Verbose, TEXT("Injected %d vertex colors into %s in %.2f ms"), NumVertexColors, *Mesh->GetName(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 int FWoWLandscapeImporterModule::M2ToEGxBlend(const int BlendingMode)
@@ -1003,80 +1706,169 @@ EBlendMode FWoWLandscapeImporterModule::EGxBlendToUE5(int BlendMode)
 	}
 }
 
-TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> FWoWLandscapeImporterModule::CreateProxyData(const int StartRow, const int StartColumn)
+void FWoWLandscapeImporterModule::LoadTileLayers(Tile &TileToLoad)
+{
+	TArray<AlphamapLayerJson> Layers;
+	if (!FWoWJsonReader::ReadAlphamapLayers(TileToLoad.AlphamapJsonPath, Layers))
+		UE_LOG(LogWoWLandscapeImporter, Warning, TEXT("Failed to read alphamap JSON %s"), *TileToLoad.AlphamapJsonPath);
+
+	for (const AlphamapLayerJson &LayerJson : Layers)
+	{
+		FString TexPathBase = LayerJson.File.Replace(TEXT("\\"), TEXT("/"));
+		FString TexPathHeight = LayerJson.HeightFile.Replace(TEXT("\\"), TEXT("/"));
+		TileToLoad.TexturePaths.FindOrAdd(LayerJson.EffectID, TTuple<FString, FString, int>(TexPathBase, TexPathHeight, 0)).Get<2>()++;
+
+		Layer NewLayer;
+		NewLayer.LayerName = FName(FPaths::GetBaseFilename(TexPathBase));
+		NewLayer.ImageIndex = LayerJson.ImageIndex;
+		NewLayer.ChannelIndex = LayerJson.ChannelIndex;
+		TileToLoad.Chunks[LayerJson.ChunkIndex].Layers.Add(NewLayer);
+	}
+}
+
+bool FWoWLandscapeImporterModule::LoadTileImages(Tile &TileToLoad)
 {
-	// Height and width of proxy in vertices(pixels)
-	const int ProxyHeight = 511;
-	const int ProxyWidth = 511;
+	if (TileToLoad.HeightmapPath.IsEmpty() || TileToLoad.HasImages())
+		return false;
+
+	if (!TileToLoad.CachePath.IsEmpty() && FWoWTileCache::MapImages(TileToLoad))
+		return true;
+
+	// The compressed file buffer is shared by the three images of this tile and freed with the load
+	TArray<uint8> FileData;
+	LoadImageData(TileToLoad.HeightmapPath, ERGBFormat::Gray, 16, FileData, TileToLoad.HeightmapData);
+	for (int j = 0; j < 2; j++)
+		LoadImageData(TileToLoad.AlphamapPaths[j], ERGBFormat::BGRA, 8, FileData, TileToLoad.AlphamapPNGs[j]);
+
+	if (!TileToLoad.CachePath.IsEmpty())
+		FWoWTileCache::Write(TileToLoad);
+	return true;
+}
+
+void FWoWLandscapeImporterModule::LoadTileRows(const int FirstRow, const int NumRows, const TSet<FIntPoint> *Proxies)
+{
+	const int LastRow = FMath::Min(FirstRow + NumRows, TileGrid.Num());
+	if (FirstRow >= LastRow)
+		return;
+
+	const int TileColumns = TileGrid[0].Num();
+	ParallelFor((LastRow - FirstRow) * TileColumns, [this, FirstRow, NumRows, TileColumns, Proxies](int32 Index)
+				{
+					const int Column = Index % TileColumns;
+					if (!Proxies || Proxies->Contains(FIntPoint(Column / NumRows * NumRows, FirstRow)))
+						LoadTileImages(TileGrid[FirstRow + Index / TileColumns][Column]); });
+}
+
+void FWoWLandscapeImporterModule::ReleaseTileRows(const int FirstRow, const int NumRows)
+{
+	const int LastRow = FMath::Min(FirstRow + NumRows, TileGrid.Num());
+	for (int Row = FirstRow; Row < LastRow; Row++)
+	{
+		for (Tile &CurrentTile : TileGrid[Row])
+			CurrentTile.ReleaseImages();
+	}
+}
+
+TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> FWoWLandscapeImporterModule::CreateProxyData(const int StartRow, const int StartColumn, const int ProxyTiles)
+{
+	// Height and width of proxy in vertices(pixels), neighbouring tiles share their border vertices
+	const int ProxyHeight = ProxyTiles * 255 + 1;
+	const int ProxyWidth = ProxyTiles * 255 + 1;
 	TArray<uint16> Heightmap;
 	Heightmap.SetNumZeroed(ProxyWidth * ProxyHeight);
-	TMap<FName, FLandscapeImportLayerInfo> LayerInfoMap;
+	TArray<FLandscapeImportLayerInfo> LayerInfoArray;
+	TMap<FName, int> LayerInfoIndices;
 
-	int CurrentRow = StartRow;
-	int TileY = 0;
-	for (int ProxyY = 0; ProxyY < ProxyHeight; ProxyY++)
+	// Destination weight buffer per alphamap image and channel (R, G, B, base), resolved once per chunk. Null when unused.
+	uint8 *ChunkWeights[2][4];
+	// Buffers of further layers reading an image channel already in ChunkWeights, as (image, channel, buffer)
+	TArray<TTuple<int, int, uint8 *>, TInlineAllocator<4>> SharedChannelWeights;
+
+	for (int TileOffsetY = 0; TileOffsetY < ProxyTiles; TileOffsetY++)
 	{
-		if (TileY == 256)
+		for (int TileOffsetX = 0; TileOffsetX < ProxyTiles; TileOffsetX++)
 		{
-			CurrentRow++;
-			TileY = 1; // We skip first row/column of subsequent tiles to avoid overlapping vertices(heightmaps share borders)
-		}
+			const int CurrentRow = StartRow + TileOffsetY;
+			const int CurrentColumn = StartColumn + TileOffsetX;
+			if (CurrentRow >= TileGrid.Num() || CurrentColumn >= TileGrid[0].Num() || !TileGrid[CurrentRow][CurrentColumn].HasImages())
+				continue; // No heightmap data for this tile, so we can just leave it as 0
 
-		int ChunkY = TileY / 16; // All heightmaps/alphamaps are now 256x256, so we dont need to worry about the special case for the first 127 pixels and can just do an integer division to get the chunk index.
-		int CurrentColumn = StartColumn;
-		int TileX = 0;
-		for (int ProxyX = 0; ProxyX < ProxyWidth; ProxyX++)
-		{
-			if (TileX == 256)
-			{
-				CurrentColumn++;
-				TileX = 1;
-			}
+			const Tile &CurrentTile = TileGrid[CurrentRow][CurrentColumn];
 
-			int ProxyIndex = ProxyY * ProxyWidth + ProxyX;
-			if (CurrentRow >= TileGrid.Num() || CurrentColumn >= TileGrid[0].Num() || TileGrid[CurrentRow][CurrentColumn].HeightmapData.Num() == 0)
-			{
-				TileX++;
-				continue; // No heightmap data for this tile, so we can just leave it as 0
-			}
+			// We skip first row/column of subsequent tiles to avoid overlapping vertices(heightmaps share borders)
+			const int FirstTileX = TileOffsetX == 0 ? 0 : 1;
+			const int FirstTileY = TileOffsetY == 0 ? 0 : 1;
+			const int ProxyOffset = TileOffsetY * 255 * ProxyWidth + TileOffsetX * 255; // Proxy index of tile pixel (0, 0)
 
-			Tile &CurrentTile = TileGrid[CurrentRow][CurrentColumn];
-			int TileIndex = TileY * 256 + TileX;
-			Heightmap[ProxyIndex] = CurrentTile.HeightmapData[TileIndex];
+			StitchTileHeightmap(CurrentTile.GetHeightmap(), FirstTileX, FirstTileY, Heightmap.GetData(), ProxyOffset, ProxyWidth);
 
-			int ChunkX = TileX / 16;
-			int ChunkIndex = ChunkY * 16 + ChunkX;
-			// Calculate the weight for each layer based on the pixel data
-			for (int LayerIndex = 0; LayerIndex < CurrentTile.Chunks[ChunkIndex].Layers.Num(); LayerIndex++)
+			// All heightmaps/alphamaps are 256x256 with 16x16 chunks of 16x16 pixels
+			for (int ChunkIndex = 0; ChunkIndex < 256; ChunkIndex++)
 			{
-				const Layer &CurrentLayer = CurrentTile.Chunks[ChunkIndex].Layers[LayerIndex];
-				FColor Pixel = TileGrid[CurrentRow][CurrentColumn].AlphamapPNGs[CurrentLayer.ImageIndex][TileIndex];
-
-				LayerMetadata *LayerMetadata = LayerMetadataMap.Find(CurrentLayer.LayerName);
-				FLandscapeImportLayerInfo &ImportLayerInfo = LayerInfoMap.FindOrAdd(CurrentLayer.LayerName);
-				if (ImportLayerInfo.LayerData.Num() == 0)
+				const TArray<Layer> &Layers = CurrentTile.Chunks[ChunkIndex].Layers;
+				if (Layers.Num() == 0)
+					continue;
+
+				FMemory::Memzero(ChunkWeights);
+				SharedChannelWeights.Reset();
+				// Backwards, so a buffer several layers write to gets the last layer's weights as in the per-pixel conversion
+				for (int LayerIndex = Layers.Num() - 1; LayerIndex >= 0; LayerIndex--)
 				{
-					ImportLayerInfo.LayerData.SetNumZeroed(ProxyWidth * ProxyHeight);
-					ImportLayerInfo.LayerInfo = LayerMetadata->LayerInfo;
-					ImportLayerInfo.LayerName = LayerMetadata->LayerInfo->LayerName;
+					const Layer &CurrentLayer = Layers[LayerIndex];
+					// The indices come straight from the alphamap JSON or tile cache. There are two images, and channels are R, G, B or -1 for the implicit base layer.
+					if (CurrentLayer.ImageIndex < 0 || CurrentLayer.ImageIndex > 1 || CurrentLayer.ChannelIndex < -1 || CurrentLayer.ChannelIndex > 2)
+					{
+						UE_LOG(LogWoWLandscapeImporter, Warning, TEXT("Skipping layer %s of tile %d_%d chunk %d with image %d channel %d"), *CurrentLayer.LayerName.ToString(), CurrentColumn, CurrentRow, ChunkIndex, CurrentLayer.ImageIndex, CurrentLayer.ChannelIndex);
+						continue;
+					}
+
+					int *LayerInfoIndex = LayerInfoIndices.Find(CurrentLayer.LayerName);
+					if (!LayerInfoIndex)
+					{
+						LayerMetadata *LayerMetadata = LayerMetadataMap.Find(CurrentLayer.LayerName);
+						if (!LayerMetadata)
+							continue;
+
+						FLandscapeImportLayerInfo &ImportLayerInfo = LayerInfoArray.AddDefaulted_GetRef();
+						ImportLayerInfo.LayerData.SetNumZeroed(ProxyWidth * ProxyHeight);
+						ImportLayerInfo.LayerInfo = LayerMetadata->LayerInfo;
+						ImportLayerInfo.LayerName = LayerMetadata->LayerInfo->LayerName;
+						LayerInfoIndex = &LayerInfoIndices.Add(CurrentLayer.LayerName, LayerInfoArray.Num() - 1);
+					}
+
+					uint8 *LayerWeights = LayerInfoArray[*LayerInfoIndex].LayerData.GetData();
+					bool bWrittenByLaterLayer = false;
+					for (const uint8 *Weights : MakeArrayView(&ChunkWeights[0][0], 8))
+						bWrittenByLaterLayer |= Weights == LayerWeights;
+					for (const TTuple<int, int, uint8 *> &Shared : SharedChannelWeights)
+						bWrittenByLaterLayer |= Shared.Get<2>() == LayerWeights;
+					if (bWrittenByLaterLayer)
+						continue;
+
+					// Every layer gets its weights, also when another layer of the chunk reads the same image channel
+					const int Channel = CurrentLayer.ChannelIndex == -1 ? 3 : CurrentLayer.ChannelIndex;
+					if (!ChunkWeights[CurrentLayer.ImageIndex][Channel])
+						ChunkWeights[CurrentLayer.ImageIndex][Channel] = LayerWeights;
+					else
+						SharedChannelWeights.Emplace(CurrentLayer.ImageIndex, Channel, LayerWeights);
 				}
 
-				switch (CurrentLayer.ChannelIndex)
+				for (int ImageIndex = 0; ImageIndex < 2; ImageIndex++)
+				{
+					uint8 *const *Weights = ChunkWeights[ImageIndex];
+					if (Weights[0] || Weights[1] || Weights[2] || Weights[3])
+						StitchChunkWeights(reinterpret_cast<const uint8 *>(CurrentTile.GetAlphamap(ImageIndex)), ChunkIndex, FirstTileX, FirstTileY, Weights, ProxyOffset, ProxyWidth);
+				}
+				for (const TTuple<int, int, uint8 *> &Shared : SharedChannelWeights)
 				{
-				case -1: ImportLayerInfo.LayerData[ProxyIndex] = 255 - Pixel.R - Pixel.G - Pixel.B; break;
-				case 0: ImportLayerInfo.LayerData[ProxyIndex] = Pixel.R; break;
-				case 1: ImportLayerInfo.LayerData[ProxyIndex] = Pixel.G; break;
-				case 2: ImportLayerInfo.LayerData[ProxyIndex] = Pixel.B; break;
+					uint8 *Weights[4] = {};
+					Weights[Shared.Get<1>()] = Shared.Get<2>();
+					StitchChunkWeights(reinterpret_cast<const uint8 *>(CurrentTile.GetAlphamap(Shared.Get<0>())), ChunkIndex, FirstTileX, FirstTileY, Weights, ProxyOffset, ProxyWidth);
 				}
 			}
-			TileX++;
 		}
-		TileY++;
 	}
 
-	TArray<FLandscapeImportLayerInfo> LayerInfoArray;
-	LayerInfoMap.GenerateValueArray(LayerInfoArray);
-
 	return MakeTuple(MoveTemp(Heightmap), MoveTemp(LayerInfoArray));
 }
 
@@ -1319,7 +2111,7 @@ UMaterial *FWoWLandscapeImporterModule::CreateModelMaterial(const FString Materi
 	return ModelMaterial;
 }
 
-void FWoWLandscapeImporterModule::CreateLandscapeMaterial(ALandscape *Landscape)
+AActor *FWoWLandscapeImporterModule::CreateLandscapeMaterial(ALandscape *Landscape)
 {
 	const FString BaseName = FPaths::GetCleanFilename(DirectoryPath);
 	const FString MaterialDirectory = FString::Printf(TEXT("/Game/Assets/WoWExport/Materials/%s"), *BaseName);
@@ -1330,22 +2122,28 @@ void FWoWLandscapeImporterModule::CreateLandscapeMaterial(ALandscape *Landscape)
 	AssetTools.CreateAsset(RVTName, MaterialDirectory, URuntimeVirtualTexture::StaticClass(), nullptr);
 
 	URuntimeVirtualTexture *RVTAsset = Cast<URuntimeVirtualTexture>(UEditorAssetLibrary::LoadAsset(RVTPackagePath));
-	Landscape->RuntimeVirtualTextures.Add(RVTAsset);
-
-	ARuntimeVirtualTextureVolume *RVTVolume = Landscape->GetWorld()->SpawnActor<ARuntimeVirtualTextureVolume>();
-	RVTVolume->SetActorLabel(FString::Printf(TEXT("RVT_Volume_%s"), *BaseName));
-	URuntimeVirtualTextureComponent *RVTComp = RVTVolume->GetComponentByClass<URuntimeVirtualTextureComponent>();
-	RVTComp->SetVirtualTexture(RVTAsset);
-
-	// Calculate the bounding box of the landscape by iterating through its proxies and set the RVT volume location and scale accordingly
-	FBox LandscapeBox(ForceInit);
-	ULandscapeInfo *LandscapeInfo = Landscape->GetLandscapeInfo();
-	LandscapeInfo->ForEachLandscapeProxy([&LandscapeBox](ALandscapeProxy *Proxy)
-										 {
-		LandscapeBox += Proxy->GetComponentsBoundingBox(true);
-		return true; });
-	RVTVolume->SetActorLocation(FVector(LandscapeBox.Min.X, LandscapeBox.Min.Y, LandscapeBox.Min.Z));
-	RVTVolume->SetActorScale3D(LandscapeBox.GetSize());
+
+	// A landscape rebuilt by an incremental reimport already has its RVT and volume
+	ARuntimeVirtualTextureVolume *RVTVolume = nullptr;
+	if (!Landscape->RuntimeVirtualTextures.Contains(RVTAsset))
+	{
+		Landscape->RuntimeVirtualTextures.Add(RVTAsset);
+
+		RVTVolume = Landscape->GetWorld()->SpawnActor<ARuntimeVirtualTextureVolume>();
+		RVTVolume->SetActorLabel(FString::Printf(TEXT("RVT_Volume_%s"), *BaseName));
+		URuntimeVirtualTextureComponent *RVTComp = RVTVolume->GetComponentByClass<URuntimeVirtualTextureComponent>();
+		RVTComp->SetVirtualTexture(RVTAsset);
+
+		// Calculate the bounding box of the landscape by iterating through its proxies and set the RVT volume location and scale accordingly
+		FBox LandscapeBox(ForceInit);
+		ULandscapeInfo *LandscapeInfo = Landscape->GetLandscapeInfo();
+		LandscapeInfo->ForEachLandscapeProxy([&LandscapeBox](ALandscapeProxy *Proxy)
+											 {
+			LandscapeBox += Proxy->GetComponentsBoundingBox(true);
+			return true; });
+		RVTVolume->SetActorLocation(FVector(LandscapeBox.Min.X, LandscapeBox.Min.Y, LandscapeBox.Min.Z));
+		RVTVolume->SetActorScale3D(LandscapeBox.GetSize());
+	}
 
 	const FString MaterialName = FString::Printf(TEXT("M_%s"), *BaseName);
 	const FString MaterialPackagePath = FString::Printf(TEXT("%s/%s"), *MaterialDirectory, *MaterialName);
@@ -1675,10 +2473,15 @@ void FWoWLandscapeImporterModule::CreateLandscapeMaterial(ALandscape *Landscape)
 	FProperty *MaterialProperty = FindFProperty<FProperty>(ALandscapeProxy::StaticClass(), FName("LandscapeMaterial"));
 	FPropertyChangedEvent MaterialPropertyChangedEvent(MaterialProperty);
 	Landscape->PostEditChangeProperty(MaterialPropertyChangedEvent);
+	return RVTVolume;
 }
 
 void FWoWLandscapeImporterModule::UpdateStatusMessage(const FString &Message, bool bIsError)
 {
+	// Also logged, as there is no window to show it in when importing from the commandlet
+	if (bIsError)
+		UE_LOG(LogWoWLandscapeImporter, Error, TEXT("%s"), *Message);
+
 	if (StatusMessageWidget.IsValid())
 	{
 		FText StatusText = FText::FromString(Message);
@@ -1719,6 +2522,18 @@ void FWoWLandscapeImporterModule::RegisterMenus()
 	}
 }
 
+bool FWoWLandscapeImporterModule::LoadImageData(const FString &FilePath, ERGBFormat RGBFormat, int32 BitDepth, TArray<uint8> &FileData, TArray64<uint8> &OutRawData)
+{
+	if (FFileHelper::LoadFileToArray(FileData, *FilePath))
+	{
+		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule->CreateImageWrapper(EImageFormat::PNG);
+		// The TArray64 overload hands over the decoder's own buffer instead of copying it
+		if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
+			return ImageWrapper->GetRaw(RGBFormat, BitDepth, OutRawData);
+	}
+	return false;
+}
+
 TSharedPtr<FJsonObject> FWoWLandscapeImporterModule::LoadJsonObject(const FString &FilePath)
 {
 	FString JsonString;
@@ -3,16 +3,26 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Async/MappedFileHandle.h"
 #include "IImageWrapper.h"
 #include "IImageWrapperModule.h"
 #include "LandscapeProxy.h"
 #include "Math/Color.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/ObjectSaveContext.h"
+#include "WoWImportManifest.h"
+#include "WoWJsonReader.h"
+#include "WorldPartition/WorldPartitionHandle.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogWoWLandscapeImporter, Log, All);
 
 class FToolBarBuilder;
 class FMenuBuilder;
 class ULandscapeLayerInfoObject;
 class ULandscapeGrassType;
+class UAssetImportData;
+class UWorldPartition;
 
 struct Layer
 {
@@ -30,10 +40,26 @@ struct Chunk
 /** Struct to represent a tile in the landscape grid */
 struct Tile
 {
-	TArray<uint16> HeightmapData;
-	TArray<TArray<FColor>> AlphamapPNGs;
+	// Decoded PNG bytes as returned by the image wrapper: a G16 heightmap and two BGRA8 alphamaps, all 256x256
+	TArray64<uint8> HeightmapData;
+	TArray<TArray64<uint8>> AlphamapPNGs;
 	TArray<Chunk> Chunks;
 
+	// Layer textures referenced by this tile: effectID -> (texture path, height texture path, number of chunk layers using it)
+	TMap<int, TTuple<FString, FString, int>> TexturePaths;
+
+	// Source files, kept so pixel data can be (re)loaded on demand when tiles are streamed. Empty for tiles without data.
+	FString HeightmapPath;
+	FString AlphamapPaths[2];
+	FString AlphamapJsonPath;
+
+	// Tile cache entry, empty when the cache is disabled. While the cache file is mapped the pixel views point into it instead of the arrays above.
+	FString CachePath;
+	FString CacheKey;
+	TUniquePtr<IMappedFileHandle> CacheFile;
+	TUniquePtr<IMappedFileRegion> CacheRegion;
+	const uint8 *MappedImages[3] = {};
+
 	uint8 Column, Row;
 
 	Tile()
@@ -41,6 +67,20 @@ struct Tile
 		Chunks.SetNum(256);
 		AlphamapPNGs.SetNum(2);
 	}
+
+	bool HasImages() const { return HeightmapData.Num() > 0 || CacheRegion.IsValid(); }
+	const uint16 *GetHeightmap() const { return reinterpret_cast<const uint16 *>(CacheRegion ? MappedImages[0] : HeightmapData.GetData()); }
+	const FColor *GetAlphamap(int ImageIndex) const { return reinterpret_cast<const FColor *>(CacheRegion ? MappedImages[1 + ImageIndex] : AlphamapPNGs[ImageIndex].GetData()); }
+
+	void ReleaseImages()
+	{
+		CacheRegion.Reset();
+		CacheFile.Reset();
+		FMemory::Memzero(MappedImages);
+		HeightmapData.Empty();
+		for (TArray64<uint8> &Alphamap : AlphamapPNGs)
+			Alphamap.Empty();
+	}
 };
 
 struct LayerMetadata
@@ -51,11 +91,15 @@ struct LayerMetadata
 	TObjectPtr<ULandscapeGrassType> FoliageAsset;
 };
 
+/** One model placement. Models and tiles are indices into tables built while parsing, so placements copy no strings. */
 struct ActorData
 {
-	FString ModelPath;
-	FString Tile;
-	FString ParentWMO;
+	/** Index of the model's full path */
+	int ModelIndex;
+	/** Index of the tile name, of the placement CSV this came from */
+	int TileIndex;
+	/** Model index of the WMO this is placed in, INDEX_NONE for placements of the map itself */
+	int ParentModelIndex = INDEX_NONE;
 	FVector Position;
 	FRotator Rotation;
 	double Scale;
@@ -63,21 +107,51 @@ struct ActorData
 	// Equality operator for TArray::Contains
 	bool operator==(const ActorData &Other) const
 	{
-		return ModelPath == Other.ModelPath &&
+		return ModelIndex == Other.ModelIndex &&
 			   Position.Equals(Other.Position, 0.1f) &&
 			   Rotation.Equals(Other.Rotation, 0.1f) &&
 			   FMath::IsNearlyEqual(Scale, Other.Scale, 0.1f);
 	}
 };
 
+/** Placement of a model inside a WMO, in the WMO's local space (centimeters) */
+struct WMOChildPlacement
+{
+	/** Index of the child model's full path, as for ActorData */
+	int ModelIndex;
+	FVector Position;
+	FQuat Rotation;
+	double Scale;
+};
+
+/** Spatial hash over placements, so duplicate checks only compare against placements of the same model in neighbouring cells */
+struct ActorDedupIndex
+{
+	/** Returns true if Actors already holds a placement equal to Actor (see ActorData::operator==) */
+	bool Contains(const TArray<ActorData> &Actors, const ActorData &Actor) const;
+
+	/** Appends Actor to Actors and indexes it */
+	void Add(TArray<ActorData> &Actors, const ActorData &Actor);
+
+private:
+	// Cells are larger than the 0.1 position tolerance, so a duplicate is always within one cell on each axis
+	static constexpr double CellSize = 1.0;
+
+	static FIntVector GetCell(const FVector &Position);
+	static uint32 GetKey(const int ModelIndex, const FIntVector &Cell);
+
+	TMultiMap<uint32, int32> Cells;
+};
+
 /** Data extracted from WoW model JSON file */
 struct JsonData
 {
-	FString FileType; // "wmo" or "m2"
+	ModelJson Model;
 
-	// Lookups
-	TMap<FString, TSharedPtr<FJsonObject>> MtlNameToMtlObject;
-	TMap<FString, TSharedPtr<FJsonObject>> MtlNameToTexUnit;
+	// Lookups, indexing into Model.Materials, Model.TextureUnits and Model.Textures
+	TMap<FString, int> MtlNameToMaterial;
+	TMap<FString, int> MtlNameToTexUnit;
+	TMap<int, int> FDIDToTexture;
 	TMap<int, FString> FDIDToTexName;
 };
 
@@ -86,8 +160,20 @@ struct MtlData
 	UMaterialInstanceConstant *Instance;
 	TMap<FName, FString> ParamToTexName;
 
+	// Instance settings, applied when the instance is created
+	TMap<FName, bool> StaticSwitches;
+	TMap<FName, float> ScalarParams;
+	TOptional<bool> TwoSided;
+	bool isTwoSidedFoliage = false;
+
 	bool isM2;
 	int BlendMode;
+
+	/** Blend mode, base property overrides and static switches, which together select the shader permutation */
+	FString GetPermutationSignature() const;
+
+	/** Everything that ends up on the instance, material names with equal signatures can share one instance */
+	FString GetSignature() const;
 };
 
 class FWoWLandscapeImporterModule : public IModuleInterface
@@ -103,58 +189,92 @@ public:
 	/** Function to handle import button click */
 	FReply OnImportButtonClicked();
 
-	/** Function to import landscape */
-	void ImportLandscape();
+	/** Function to import landscape, from the map exported to MapDirectory into the current editor world. Returns false if the map could not be read or any of its assets or placements failed to import */
+	bool ImportLandscape(const FString &MapDirectory);
+
+	/** Writes the manifest of the last import, which has to wait until its level is saved. Returns false if writing failed. */
+	bool WritePendingManifest();
 
 private:
+	friend class UWoWLandscapeImportCommandlet;
+	friend class FWoWModelSidecarReimportTest;
+	friend class FWoWProxyStitchingTest;
+
 	void RegisterMenus();
 
+	/** Writes the pending manifest once the editor has saved the level it describes */
+	void OnPostSaveWorld(UWorld *World, FObjectPostSaveContext ObjectSaveContext);
+
 	TSharedRef<class SDockTab> OnSpawnPluginTab(const class FSpawnTabArgs &SpawnTabArgs);
+	TSharedRef<class SWidget> MakeOptionCheckBox(const FText &Label, bool *Option);
+	TSharedRef<class SWidget> MakeOptionSpinBox(const FText &Label, int *Option, int MinValue, int MaxValue);
 
 	/** Update the status message in the UI */
 	void UpdateStatusMessage(const FString &Message, bool bIsError = false);
 
-	/** Function to import and create landscape layers */
-	void ImportLayers(TMap<int, TTuple<FString, FString, int>> &TexturePaths, TArray<FString> &FoliageFiles, TArray<FString> &FoliageJSONs, UMaterial *ModelMaterial);
+	/** Function to import and create landscape layers. Returns how many layer textures and foliage meshes failed to import */
+	int ImportLayers(TMap<int, TTuple<FString, FString, int>> &TexturePaths, TArray<FString> &FoliageFiles, TArray<FString> &FoliageJSONs, UMaterial *ModelMaterial);
+
+	/** Fills LayerMetadataMap from the layer assets of a previous import, returns false if any of them is missing */
+	bool LoadExistingLayers(const TMap<int, TTuple<FString, FString, int>> &TexturePaths);
+
+	/** Imports the models and returns their meshes keyed by full source path, as base filenames repeat across directories */
+	TMap<FString, UStaticMesh *> ImportModels(TArray<FString> &ModelPaths, UMaterial *ModelMaterial, bool isFoliage = false);
+
+	/**
+	 * Finds the asset Interchange imported from SourcePath into DestinationDirectory, if neither the file nor the sidecar files recorded
+	 * with the asset (in SidecarPaths order) have changed since. Safe to call from worker threads.
+	 */
+	FAssetData FindUnchangedAsset(const FString &DestinationDirectory, const FString &SourcePath, TConstArrayView<FString> SidecarPaths = {}) const;
 
-	TArray<UStaticMesh *> ImportModels(TArray<FString> &ModelPaths, UMaterial *ModelMaterial, bool isFoliage = false);
+	/** Files next to a model that go into its mesh: material data, materials and collision. They may not all exist. */
+	static TArray<FString> GetModelSidecarPaths(const FString &ModelPath);
+
+	/** Records the hashes of the model's sidecar files in the import data, after the model itself, for FindUnchangedAsset */
+	static void RecordModelSidecars(UAssetImportData *AssetImportData, const FString &ModelPath);
+
+	/** Blocks until one of NumPending Interchange imports is done and returns its index, pumping game thread tasks in the meantime */
+	int WaitForAnyImport(const int NumPending, TFunctionRef<bool(int)> IsImportDone);
 
 	/** Preprocessing and helper functions for model import */
-	JsonData ParseModelJson(const TSharedPtr<FJsonObject> &JsonObject);
-	void InjectVertexColors(UStaticMesh *Mesh, const TSharedPtr<FJsonObject> &JsonObject);
+	JsonData ParseModelJson(const FString &JsonPath);
+	void InjectVertexColors(UStaticMesh *Mesh, const ModelJson &Model);
 	int M2ToEGxBlend(const int BlendingMode);
 	EBlendMode EGxBlendToUE5(int BlendMode);
 
+	/** Tile residency helpers, used to stream pixel data in and out around the proxy cursor */
+	void LoadTileLayers(Tile &TileToLoad);
+	bool LoadTileImages(Tile &TileToLoad);
+	/** Loads the tiles of a row of proxies NumRows tiles wide, or only those of Proxies (keyed by their first tile) when it is given */
+	void LoadTileRows(const int FirstRow, const int NumRows, const TSet<FIntPoint> *Proxies = nullptr);
+	void ReleaseTileRows(const int FirstRow, const int NumRows);
+
+	/** Spawns a single hierarchical instanced static mesh actor for all placements of a model in one folder */
+	AActor *SpawnInstancedModelActor(UStaticMesh *Mesh, const FString &ModelName, const FString &FolderPath, const TArray<ActorData> &Actors, const TArray<int> &ActorIndices);
+
+	/** Finds an actor of a previous import, loading it through References when its world partition cell is not loaded. Returns null if it is gone. */
+	AActor *FindManifestActor(UWorldPartition *WorldPartition, const FGuid &ActorGuid, const TMap<FGuid, AActor *> &LoadedActors, TArray<FWorldPartitionReference> &References);
+
+	/** Removes the actors of a previous import from the level, unregistering streaming proxies from their landscape first. Returns how many were found */
+	int DestroyManifestActors(UWorldPartition *WorldPartition, const TArray<FGuid> &ActorGuids, const TMap<FGuid, AActor *> &ActorsByGuid);
+
+	/**
+	 * Parses the child placements of a WMO from its own _ModelPlacementInformation.csv. InternModelPath maps the full path of a
+	 * child model to its model index, or INDEX_NONE to skip the child.
+	 */
+	TArray<WMOChildPlacement> ParseWMOPlacements(const FString &WMOModelPath, TFunctionRef<int(const FString &)> InternModelPath);
+
 	/** Function to create proxy data for landscape import */
-	TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> CreateProxyData(const int Row, const int Column);
+	TTuple<TArray<uint16>, TArray<FLandscapeImportLayerInfo>> CreateProxyData(const int Row, const int Column, const int ProxyTiles);
 
 	/** Helper functions*/
 	TSharedPtr<FJsonObject> LoadJsonObject(const FString &FilePath);
-	template <typename ArrayType>
-	bool LoadImageData(const FString &FilePath, ERGBFormat RGBFormat, int32 BitDepth, TArray<ArrayType> &OutRawData)
-	{
-		TArray<uint8> FileData;
-		if (FFileHelper::LoadFileToArray(FileData, *FilePath))
-		{
-			IImageWrapperModule &ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-			TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-			if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
-			{
-				TArray<uint8> RawData;
-				if (ImageWrapper->GetRaw(RGBFormat, BitDepth, RawData))
-				{
-					OutRawData.SetNumUninitialized(RawData.Num() / sizeof(ArrayType));
-					FMemory::Memcpy(OutRawData.GetData(), RawData.GetData(), RawData.Num());
-					return true;
-				}
-			}
-		}
-		return false;
-	}
+	bool LoadImageData(const FString &FilePath, ERGBFormat RGBFormat, int32 BitDepth, TArray<uint8> &FileData, TArray64<uint8> &OutRawData);
 
 	UMaterial *CreateModelMaterial(const FString MaterialName);
 
-	void CreateLandscapeMaterial(ALandscape *Landscape);
+	/** Builds the landscape material and its runtime virtual texture. Returns the RVT volume it spawned, or null if the landscape already had one. */
+	AActor *CreateLandscapeMaterial(ALandscape *Landscape);
 
 	template <typename NodeType>
 	NodeType *CreateNode(NodeType *NewObject, int32 EditorX, int32 EditorY, UMaterial *LandscapeMaterial)
@@ -168,16 +288,43 @@ private:
 
 	TSharedPtr<class FUICommandList> PluginCommands;
 
+	/** Cached on startup so decode workers never go through the module manager */
+	IImageWrapperModule *ImageWrapperModule = nullptr;
+
 	/** Status message widget reference */
 	TSharedPtr<class STextBlock> StatusMessageWidget;
 
-	/** Components per proxy setting */
+	/** Components per proxy setting, each component covers 2x2 tiles */
 	int WPGridSize = 1;
 
+	/** Only keep the tile rows around the proxy cursor resident instead of the whole TileGrid */
+	bool bStreamTiles = true;
+
+	/** Keep decoded tiles in Saved/WoWLandscapeImporter/TileCache so reimports of an unchanged map skip PNG and JSON decoding */
+	bool bUseTileCache = true;
+
+	/** Batch placements of the same model within a tile folder into instanced mesh components, once there are at least InstancingThreshold of them */
+	bool bInstanceModels = false;
+	int InstancingThreshold = 8;
+
+	/** Reuse the landscape of the last import of the map and only rebuild the proxies and placements whose source files changed since */
+	bool bIncrementalReimport = false;
+
+	/** Reuse textures and meshes already imported from an unchanged source file instead of importing them again */
+	bool bSkipExistingAssets = false;
+
+	/** Upper bound on model imports handed to Interchange at once */
+	int MaxConcurrentImports = 16;
+
 	TArray<TArray<Tile>> TileGrid;
 	FString DirectoryPath;
 	FString OBJFilePath;
 
 	/** Key-value store for data and metadata of landscape layers */
 	TMap<FName, LayerMetadata> LayerMetadataMap;
+
+	/** Manifest of the last import, kept until its level is saved so it never refers to actors that only exist in memory */
+	TOptional<FWoWImportManifest> PendingManifest;
+	FString PendingManifestMapName;
+	TWeakObjectPtr<UWorld> PendingManifestWorld;
 };
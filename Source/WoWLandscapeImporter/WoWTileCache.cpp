@@ -0,0 +1,178 @@
+#include "WoWTileCache.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "WoWLandscapeImporter.h"
+
+static const uint32 TileCacheMagic = 0x43544F57; // "WOTC"
+static const int32 TileCacheVersion = 1;
+static const int64 TileCacheAlignment = 64;
+
+/** Reads and validates the header, storing the layer table in OutTile when it is given */
+static bool ReadHeader(FArchive &Ar, const FString &Key, Tile *OutTile, int64 (&OutImageSizes)[3])
+{
+	uint32 Magic = 0;
+	int32 Version = 0;
+	FString FileKey;
+	Ar << Magic << Version;
+	if (Ar.IsError() || Magic != TileCacheMagic || Version != TileCacheVersion)
+		return false;
+	Ar << FileKey;
+	if (Ar.IsError() || FileKey != Key)
+		return false;
+
+	int32 NumTexturePaths = 0;
+	Ar << NumTexturePaths;
+	for (int32 i = 0; i < NumTexturePaths && !Ar.IsError(); i++)
+	{
+		int32 EffectID = 0, Count = 0;
+		FString TexPathBase, TexPathHeight;
+		Ar << EffectID << TexPathBase << TexPathHeight << Count;
+		if (OutTile)
+			OutTile->TexturePaths.Add(EffectID, TTuple<FString, FString, int>(TexPathBase, TexPathHeight, Count));
+	}
+
+	for (int32 ChunkIndex = 0; ChunkIndex < 256 && !Ar.IsError(); ChunkIndex++)
+	{
+		int32 NumLayers = 0;
+		Ar << NumLayers;
+		for (int32 i = 0; i < NumLayers && !Ar.IsError(); i++)
+		{
+			FString LayerName;
+			Layer NewLayer;
+			Ar << LayerName << NewLayer.ImageIndex << NewLayer.ChannelIndex;
+			NewLayer.LayerName = FName(*LayerName);
+			if (OutTile)
+				OutTile->Chunks[ChunkIndex].Layers.Add(NewLayer);
+		}
+	}
+
+	for (int64 &ImageSize : OutImageSizes)
+		Ar << ImageSize;
+	return !Ar.IsError();
+}
+
+FString FWoWTileCache::GetCachePath(const FString &MapName, const FString &HeightmapFile)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WoWLandscapeImporter/TileCache"), MapName, FPaths::GetBaseFilename(HeightmapFile) + TEXT(".tile"));
+}
+
+FString FWoWTileCache::ComputeKey(const Tile &CachedTile)
+{
+	FString Key;
+	for (const FString *SourcePath : {&CachedTile.HeightmapPath, &CachedTile.AlphamapPaths[0], &CachedTile.AlphamapPaths[1], &CachedTile.AlphamapJsonPath})
+		Key += LexToString(FMD5Hash::HashFile(**SourcePath)) + TEXT(";");
+	return Key;
+}
+
+bool FWoWTileCache::ReadLayers(Tile &CachedTile)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*CachedTile.CachePath, FILEREAD_Silent));
+	if (!Reader)
+		return false;
+
+	int64 ImageSizes[3];
+	if (ReadHeader(*Reader, CachedTile.CacheKey, nullptr, ImageSizes))
+	{
+		// Only fill the tile once the whole header is known to be valid
+		Reader->Seek(0);
+		return ReadHeader(*Reader, CachedTile.CacheKey, &CachedTile, ImageSizes);
+	}
+	return false;
+}
+
+bool FWoWTileCache::MapImages(Tile &CachedTile)
+{
+	TUniquePtr<IMappedFileHandle> CacheFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CachedTile.CachePath));
+	if (!CacheFile)
+		return false;
+	TUniquePtr<IMappedFileRegion> CacheRegion(CacheFile->MapRegion());
+	if (!CacheRegion)
+		return false;
+
+	const uint8 *MappedData = CacheRegion->GetMappedPtr();
+	const int64 MappedSize = CacheRegion->GetMappedSize();
+	FMemoryReaderView Reader(MakeArrayView(MappedData, MappedSize));
+	int64 ImageSizes[3];
+	if (!ReadHeader(Reader, CachedTile.CacheKey, nullptr, ImageSizes))
+		return false;
+
+	// Each image starts on an aligned offset after the header, a truncated file is treated as stale
+	int64 Offset = Align(Reader.Tell(), TileCacheAlignment);
+	const uint8 *MappedImages[3];
+	for (int i = 0; i < 3; i++)
+	{
+		if (ImageSizes[i] <= 0 || Offset + ImageSizes[i] > MappedSize)
+			return false;
+		MappedImages[i] = MappedData + Offset;
+		Offset = Align(Offset + ImageSizes[i], TileCacheAlignment);
+	}
+
+	CachedTile.CacheFile = MoveTemp(CacheFile);
+	CachedTile.CacheRegion = MoveTemp(CacheRegion);
+	FMemory::Memcpy(CachedTile.MappedImages, MappedImages, sizeof(MappedImages));
+	return true;
+}
+
+bool FWoWTileCache::Write(const Tile &CachedTile)
+{
+	const TArray64<uint8> *Images[3] = {&CachedTile.HeightmapData, &CachedTile.AlphamapPNGs[0], &CachedTile.AlphamapPNGs[1]};
+	for (const TArray64<uint8> *Image : Images)
+		if (Image->Num() == 0)
+			return false;
+
+	// Written under a temporary name and moved into place, so an interrupted write never leaves a valid looking file
+	const FString TempPath = CachedTile.CachePath + TEXT(".tmp");
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Writer)
+			return false;
+
+		uint32 Magic = TileCacheMagic;
+		int32 Version = TileCacheVersion;
+		FString Key = CachedTile.CacheKey;
+		*Writer << Magic << Version << Key;
+
+		int32 NumTexturePaths = CachedTile.TexturePaths.Num();
+		*Writer << NumTexturePaths;
+		for (const TPair<int, TTuple<FString, FString, int>> &TexturePath : CachedTile.TexturePaths)
+		{
+			int32 EffectID = TexturePath.Key;
+			FString TexPathBase = TexturePath.Value.Get<0>();
+			FString TexPathHeight = TexturePath.Value.Get<1>();
+			int32 Count = TexturePath.Value.Get<2>();
+			*Writer << EffectID << TexPathBase << TexPathHeight << Count;
+		}
+
+		for (const Chunk &CurrentChunk : CachedTile.Chunks)
+		{
+			int32 NumLayers = CurrentChunk.Layers.Num();
+			*Writer << NumLayers;
+			for (const Layer &CurrentLayer : CurrentChunk.Layers)
+			{
+				FString LayerName = CurrentLayer.LayerName.ToString();
+				int32 ImageIndex = CurrentLayer.ImageIndex;
+				int32 ChannelIndex = CurrentLayer.ChannelIndex;
+				*Writer << LayerName << ImageIndex << ChannelIndex;
+			}
+		}
+
+		for (const TArray64<uint8> *Image : Images)
+		{
+			int64 ImageSize = Image->Num();
+			*Writer << ImageSize;
+		}
+
+		static const uint8 Padding[TileCacheAlignment] = {};
+		for (const TArray64<uint8> *Image : Images)
+		{
+			Writer->Serialize(const_cast<uint8 *>(Padding), Align(Writer->Tell(), TileCacheAlignment) - Writer->Tell());
+			Writer->Serialize(const_cast<uint8 *>(Image->GetData()), Image->Num());
+		}
+
+		if (!Writer->Close())
+			return false;
+	}
+	return IFileManager::Get().Move(*CachedTile.CachePath, *TempPath, true, true, false, true);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct Tile;
+
+/**
+ * Persistent cache of decoded tiles. Each tile is stored as one file holding its alphamap layer table followed by
+ * the raw heightmap and alphamap pixels, and is keyed by the MD5 of the tile's source files.
+ */
+class FWoWTileCache
+{
+public:
+	/** Cache file of a tile, under Saved/WoWLandscapeImporter/TileCache/<MapName> */
+	static FString GetCachePath(const FString &MapName, const FString &HeightmapFile);
+
+	/** MD5 of every source file of the tile. Hashes the whole tile, so it is meant for worker threads. */
+	static FString ComputeKey(const Tile &CachedTile);
+
+	/** Restores the chunk layers and texture references of a tile, returns false if the cache file is missing or stale */
+	static bool ReadLayers(Tile &CachedTile);
+
+	/** Memory-maps the pixel data of a tile, returns false if the cache file is missing or stale */
+	static bool MapImages(Tile &CachedTile);
+
+	/** Writes a tile whose layers and pixel data are loaded */
+	static bool Write(const Tile &CachedTile);
+};
@@ -0,0 +1,273 @@
+// Throughput of the engine-free import kernels on synthetic data: proxy assembly, ADT and WMO placement CSV parsing,
+// alphamap decode and vertex color conversion. Data is generated from a fixed seed, so runs are comparable. Pass --quick for a short run.
+
+#include "WoWLandscapeCore/WoWMeshKernels.h"
+#include "WoWLandscapeCore/WoWPlacementCsv.h"
+#include "WoWLandscapeCore/WoWPlacementKernels.h"
+#include "WoWLandscapeCore/WoWTileKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/** Results are folded into this, so the compiler cannot drop the work being timed */
+static volatile double Sink = 0.0;
+
+/** Runs Body at least once and until MinSeconds have passed, returns the average seconds per run */
+template <typename BodyType>
+static double TimeRuns(const double MinSeconds, BodyType &&Body)
+{
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point StartTime = Clock::now();
+	int NumRuns = 0;
+	double Seconds = 0.0;
+	do
+	{
+		Body();
+		NumRuns++;
+		Seconds = std::chrono::duration<double>(Clock::now() - StartTime).count();
+	} while (Seconds < MinSeconds);
+	return Seconds / NumRuns;
+}
+
+/** Decoded pixels of one tile, as the importer holds them: a G16 heightmap and two BGRA8 alphamaps, all 256x256 */
+struct SyntheticTile
+{
+	std::vector<uint16_t> Heights;
+	std::vector<uint8_t> Alphamaps[2];
+};
+
+static std::vector<SyntheticTile> MakeTiles(const int NumTiles, std::mt19937 &Random)
+{
+	std::vector<SyntheticTile> Tiles(NumTiles);
+	for (SyntheticTile &Tile : Tiles)
+	{
+		Tile.Heights.resize(256 * 256);
+		for (uint16_t &Height : Tile.Heights)
+			Height = static_cast<uint16_t>(Random());
+		for (std::vector<uint8_t> &Alphamap : Tile.Alphamaps)
+		{
+			Alphamap.resize(256 * 256 * 4);
+			for (uint8_t &Byte : Alphamap)
+				Byte = static_cast<uint8_t>(Random());
+		}
+	}
+	return Tiles;
+}
+
+static void BenchmarkProxyAssembly(const double MinSeconds, std::mt19937 &Random)
+{
+	// Proxy of the default grid size, every chunk blending the four weights of the first alphamap and one of the second
+	constexpr int ProxyTiles = 4;
+	constexpr int ProxyWidth = ProxyTiles * 255 + 1;
+	constexpr int NumLayers = 5;
+	const std::vector<SyntheticTile> Tiles = MakeTiles(ProxyTiles * ProxyTiles, Random);
+
+	std::vector<uint16_t> Heightmap(ProxyWidth * ProxyWidth);
+	std::vector<std::vector<uint8_t>> LayerData(NumLayers, std::vector<uint8_t>(ProxyWidth * ProxyWidth));
+	const double Seconds = TimeRuns(MinSeconds, [&]()
+									{
+		// The importer starts every proxy from zeroed buffers, so clearing them is part of the cost
+		std::fill(Heightmap.begin(), Heightmap.end(), uint16_t(0));
+		for (std::vector<uint8_t> &Layer : LayerData)
+			std::fill(Layer.begin(), Layer.end(), uint8_t(0));
+
+		uint8_t *const Weights[2][4] = {{LayerData[0].data(), LayerData[1].data(), LayerData[2].data(), LayerData[3].data()}, {LayerData[4].data(), nullptr, nullptr, nullptr}};
+		for (int TileOffsetY = 0; TileOffsetY < ProxyTiles; TileOffsetY++)
+		{
+			for (int TileOffsetX = 0; TileOffsetX < ProxyTiles; TileOffsetX++)
+			{
+				const SyntheticTile &Tile = Tiles[TileOffsetY * ProxyTiles + TileOffsetX];
+				const int FirstX = TileOffsetX == 0 ? 0 : 1;
+				const int FirstY = TileOffsetY == 0 ? 0 : 1;
+				const int ProxyOffset = TileOffsetY * 255 * ProxyWidth + TileOffsetX * 255;
+
+				StitchTileHeightmap(Tile.Heights.data(), FirstX, FirstY, Heightmap.data(), ProxyOffset, ProxyWidth);
+				for (int ChunkIndex = 0; ChunkIndex < 256; ChunkIndex++)
+					for (int ImageIndex = 0; ImageIndex < 2; ImageIndex++)
+						StitchChunkWeights(Tile.Alphamaps[ImageIndex].data(), ChunkIndex, FirstX, FirstY, Weights[ImageIndex], ProxyOffset, ProxyWidth);
+			}
+		}
+		Sink = Sink + Heightmap[ProxyWidth * ProxyWidth / 2] + LayerData[4][ProxyWidth * ProxyWidth / 2]; });
+
+	std::printf("Proxy assembly     %10.1f proxies/s   %d x %d tiles, %d layers\n", 1.0 / Seconds, ProxyTiles, ProxyTiles, NumLayers);
+}
+
+/** An ADT placement CSV as exported by wow.export, with doodads drawn from a shared pool of NumModels paths */
+static std::string MakeMapPlacementCsv(const int NumRows, const int NumModels, std::mt19937 &Random)
+{
+	std::uniform_real_distribution<double> Coordinate(-17000.0, 17000.0);
+	std::uniform_real_distribution<double> Angle(0.0, 360.0);
+	std::uniform_int_distribution<int> Model(0, NumModels - 1);
+
+	std::string Csv = "\xEF\xBB\xBFModelFile;PositionX;PositionY;PositionZ;RotationX;RotationY;RotationZ;RotationW;ScaleFactor;ModelId;Type;FileDataID\r\n";
+	char Line[512];
+	for (int i = 0; i < NumRows; i++)
+	{
+		const int ModelIndex = Model(Random);
+		const bool bIsWMO = ModelIndex % 16 == 0;
+		const int Length = std::snprintf(Line, sizeof(Line), "../../world/%s/model_%05d.obj;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;0;%.6f;%d;%s;%d\r\n",
+										 bIsWMO ? "wmo" : "generic/doodads", ModelIndex, Coordinate(Random), Coordinate(Random) / 100.0, Coordinate(Random),
+										 Angle(Random), Angle(Random), Angle(Random), bIsWMO ? 1.0 : 0.5 + Angle(Random) / 360.0, i, bIsWMO ? "wmo" : "m2", 100000 + ModelIndex);
+		Csv.append(Line, Length);
+	}
+	return Csv;
+}
+
+static void BenchmarkMapPlacementCsv(const double MinSeconds, const int NumRows, std::mt19937 &Random)
+{
+	const std::string Csv = MakeMapPlacementCsv(NumRows, 4000, Random);
+
+	int NumParsed = 0;
+	const double Seconds = TimeRuns(MinSeconds, [&]()
+									{
+		// Same per-row work as the importer's CSV pass, without the engine types
+		PlacementCsvReader Reader(Csv.data(), Csv.size());
+		PlacementCsvRow Row;
+		PlacementPathTable ModelPathTable;
+		double Sum = 0.0;
+		NumParsed = 0;
+		while (Reader.ReadRow(Row))
+		{
+			double Values[PlacementValueCount];
+			if (Row.NumFields < 11 || !ReadPlacementValues(Row, Values))
+				continue;
+			const int ModelIndex = ModelPathTable.Intern(Row.Fields[0]);
+			const PlacementTransform Transform = ConvertMapPlacement(Values, Row.Fields[10] == "gobj", 0.0);
+			Sum += Transform.Position[0] + ModelIndex;
+			NumParsed++;
+		}
+		Sink = Sink + Sum; });
+
+	std::printf("ADT placement CSV  %10.0f rows/s      %d rows, %.1f MB/s\n", NumParsed / Seconds, NumParsed, Csv.size() / Seconds / (1024.0 * 1024.0));
+}
+
+/** A WMO's own placement CSV as exported by wow.export, with children placed by quaternion relative to the WMO */
+static std::string MakeWMOPlacementCsv(const int NumRows, const int NumModels, std::mt19937 &Random)
+{
+	std::uniform_real_distribution<double> Coordinate(-500.0, 500.0);
+	std::uniform_real_distribution<double> Component(-1.0, 1.0);
+	std::uniform_int_distribution<int> Model(0, NumModels - 1);
+
+	std::string Csv = "\xEF\xBB\xBFModelFile;PositionX;PositionY;PositionZ;RotationW;RotationX;RotationY;RotationZ;ScaleFactor;DoodadSet;FileDataID\r\n";
+	char Line[512];
+	for (int i = 0; i < NumRows; i++)
+	{
+		const int ModelIndex = Model(Random);
+		const int Length = std::snprintf(Line, sizeof(Line), "../../generic/doodads/model_%05d.obj;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;%.6f;Set_%d;%d\r\n",
+										 ModelIndex, Coordinate(Random), Coordinate(Random), Coordinate(Random), Component(Random), Component(Random),
+										 Component(Random), Component(Random), 1.0 + Component(Random) / 2.0, i % 4, 200000 + ModelIndex);
+		Csv.append(Line, Length);
+	}
+	return Csv;
+}
+
+static void BenchmarkWMOPlacementCsv(const double MinSeconds, const int NumRows, std::mt19937 &Random)
+{
+	const std::string Csv = MakeWMOPlacementCsv(NumRows, 500, Random);
+
+	int NumParsed = 0;
+	const double Seconds = TimeRuns(MinSeconds, [&]()
+									{
+		// Same per-row work as ParseWMOPlacements, without resolving the paths against the file system
+		PlacementCsvReader Reader(Csv.data(), Csv.size());
+		PlacementCsvRow Row;
+		PlacementPathTable ModelPathTable;
+		double Sum = 0.0;
+		NumParsed = 0;
+		while (Reader.ReadRow(Row))
+		{
+			double Values[PlacementValueCount];
+			if (!ReadPlacementValues(Row, Values))
+				continue;
+			const int ModelIndex = ModelPathTable.Intern(Row.Fields[0]);
+			const PlacementTransform Transform = ConvertWMOChildPlacement(Values);
+			Sum += Transform.Quat[3] + ModelIndex;
+			NumParsed++;
+		}
+		Sink = Sink + Sum; });
+
+	std::printf("WMO placement CSV  %10.0f rows/s      %d rows, %.1f MB/s\n", NumParsed / Seconds, NumParsed, Csv.size() / Seconds / (1024.0 * 1024.0));
+}
+
+static void BenchmarkAlphamapDecode(const double MinSeconds, const int NumTiles, std::mt19937 &Random)
+{
+	const std::vector<SyntheticTile> Tiles = MakeTiles(NumTiles, Random);
+	std::vector<uint8_t> Planes[4];
+	for (std::vector<uint8_t> &Plane : Planes)
+		Plane.resize(256 * 256);
+	const double Megabytes = NumTiles * 2 * 256.0 * 256.0 * 4.0 / (1024.0 * 1024.0);
+
+	// Every alphamap of every tile is split into all four weight planes
+	auto Decode = [&](decltype(&DeinterleaveAlphamapWeights) Kernel)
+	{
+		return TimeRuns(MinSeconds, [&]()
+						{
+			for (const SyntheticTile &Tile : Tiles)
+				for (const std::vector<uint8_t> &Alphamap : Tile.Alphamaps)
+					Kernel(Alphamap.data(), 256 * 256, Planes[0].data(), Planes[1].data(), Planes[2].data(), Planes[3].data());
+			Sink = Sink + Planes[3][12345]; });
+	};
+	const double Seconds = Decode(&DeinterleaveAlphamapWeights);
+	const double ScalarSeconds = Decode(&DeinterleaveAlphamapWeightsScalar);
+
+	std::printf("Alphamap decode    %10.1f MB/s        %d tiles, scalar %.1f MB/s\n", Megabytes / Seconds, NumTiles, Megabytes / ScalarSeconds);
+}
+
+/** Returns false if the kernel does not convert every color exactly like the baseline */
+static bool BenchmarkVertexColors(const double MinSeconds, const int NumColors, std::mt19937 &Random)
+{
+	std::vector<uint8_t> BGRAColors(NumColors * 4);
+	for (uint8_t &Byte : BGRAColors)
+		Byte = static_cast<uint8_t>(Random());
+	std::vector<float> RGBAColors(NumColors * 4);
+
+	const double Seconds = TimeRuns(MinSeconds, [&]()
+									{
+		ConvertVertexColors(BGRAColors.data(), NumColors, RGBAColors.data());
+		Sink = Sink + RGBAColors[NumColors / 2]; });
+
+	// The conversion this replaced, as the baseline: every channel is a JSON number (a double), divided by 255 and narrowed
+	// to float, and colors are appended one by one
+	const std::vector<double> JsonColors(BGRAColors.begin(), BGRAColors.end());
+	std::vector<float> BaselineColors;
+	const double BaselineSeconds = TimeRuns(MinSeconds, [&]()
+											{
+		BaselineColors.clear();
+		for (size_t c = 0; c < JsonColors.size(); c += 4)
+		{
+			const float B = JsonColors[c] / 255.0f;
+			const float G = JsonColors[c + 1] / 255.0f;
+			const float R = JsonColors[c + 2] / 255.0f;
+			const float A = JsonColors[c + 3] / 255.0f;
+			BaselineColors.insert(BaselineColors.end(), {R, G, B, A});
+		}
+		Sink = Sink + BaselineColors[NumColors / 2]; });
+
+	std::printf("Vertex colors      %10.1f M colors/s  %d colors, baseline %.1f M colors/s\n", NumColors / Seconds / 1e6, NumColors, NumColors / BaselineSeconds / 1e6);
+	return BaselineColors == RGBAColors;
+}
+
+int main(int argc, char **argv)
+{
+	bool bQuick = false;
+	for (int i = 1; i < argc; i++)
+		bQuick |= std::strcmp(argv[i], "--quick") == 0;
+	const double MinSeconds = bQuick ? 0.01 : 1.0;
+
+	std::mt19937 Random(0x574F57);
+	BenchmarkProxyAssembly(MinSeconds, Random);
+	BenchmarkMapPlacementCsv(MinSeconds, bQuick ? 10000 : 500000, Random);
+	BenchmarkWMOPlacementCsv(MinSeconds, bQuick ? 10000 : 200000, Random);
+	BenchmarkAlphamapDecode(MinSeconds, bQuick ? 4 : 64, Random);
+	if (!BenchmarkVertexColors(MinSeconds, bQuick ? 10000 : 1000000, Random))
+	{
+		std::printf("Vertex colors differ from the baseline conversion\n");
+		return 1;
+	}
+	return 0;
+}